@@ -0,0 +1,52 @@
+#ifndef ACCESSOR_VIEW_CLASS_H
+#define ACCESSOR_VIEW_CLASS_H
+
+#include <cstddef>
+#include <cstring>
+
+// AccessorView class that reads typed elements straight out of a glTF buffer
+// glTFバッファから型付きの要素を直接読み取るAccessorViewクラス
+template <typename T>
+class AccessorView
+{
+public:
+
+	// Constructor that creates an empty view
+	// 空のビューを作成するコンストラクタ
+	AccessorView() = default;
+
+	// Constructor that views count elements starting at data, stride bytes apart
+	// dataから始まり、strideバイト間隔で並ぶcount個の要素を参照するコンストラクタ
+	AccessorView(const unsigned char* data, size_t count, size_t stride = sizeof(T))
+		: data(data), count(count), stride(stride) {
+	}
+
+	// Returns the number of elements in the view
+	// ビュー内の要素数を返す
+	inline size_t Size() const { return count; }
+
+	// Returns element i (memcpy because glTF data is not guaranteed to be aligned for T)
+	// 要素iを返す（glTFデータはTに対して整列が保証されないためmemcpyを使う）
+	inline T operator[](size_t i) const
+	{
+		T value;
+		std::memcpy(&value, data + i * stride, sizeof(T));
+		return value;
+	}
+
+private:
+
+	// First byte of the first element
+	// 最初の要素の先頭バイト
+	const unsigned char* data = nullptr;
+
+	// Number of elements
+	// 要素数
+	size_t count = 0;
+
+	// Distance in bytes between consecutive elements
+	// 連続する要素間のバイト距離
+	size_t stride = sizeof(T);
+};
+
+#endif
\ No newline at end of file
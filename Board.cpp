@@ -2,7 +2,27 @@
 
 // Constructor that builds the board and initializes card positions
 // ボードを構築し、カードの初期配置を行うコンストラクタ
-Board::Board(const char* cardModels[]) {
+Board::Board(ModelCache& modelCache, const char* cardModels[]) {
+
+	// The plain card is loaded up front and stands in for every face-down card, whose backs all look the same
+	// (it has a face of its own, so a card never shows it face up; it keeps its pixels so Pin can move its
+	// texture into the face array)
+	// 無地のカードを先に読み込み、裏がすべて同じに見える裏向きのカードの代わりとして使う
+	// （自身の表面を持つため、表向きのカードには使わない。Pinがテクスチャを表面配列に移せるよう、ピクセルを保持する）
+	std::shared_ptr<Model> placeholder = modelCache.Load(cardModels[0], RETAIN_PIXELS);
+
+	// Stream the card designs so the board is playable before they finish loading;
+	// their face textures are only uploaded once a card is about to show its face
+	// 読み込みが終わる前にボードを遊べるよう、カードデザインをストリーミングする
+	// 表面テクスチャはカードが表面を見せる直前にのみ転送する
+	std::vector<std::shared_ptr<Model>> designs;
+	for (int i = 0; i < 4; i++)
+		designs.push_back(modelCache.Stream(cardModels[i], true));
+	TextureResidency* residency = &modelCache.GetTextureResidency();
+
+	// The plain card is drawn all the time, so its texture lives in the face array for good
+	// 無地のカードは常に描画されるため、そのテクスチャは表面配列に常駐させる
+	residency->Pin(placeholder);
 
 	// Create a temporary pool containing duplicated model paths for pairing
 	// ペアを作るためにモデルパスを複製した一時プールを作成する
@@ -34,9 +54,9 @@ Board::Board(const char* cardModels[]) {
 	// シャッフルされたプールからCardオブジェクトを作成する
 	for (auto& pair : cardPool)
 	{
-		// Construct card using model path
-		// モデルパスを使ってカードを生成する
-		Card card(pair.first);
+		// Construct card using the shared model of its design
+		// デザインに対応する共有モデルを使ってカードを生成する
+		Card card(designs[pair.second], placeholder, residency);
 
 		// Assign matching ID for pair checking
 		// ペア判定用のIDを設定する
@@ -7,6 +7,7 @@
 #include <random>
 #include <glm/gtx/string_cast.hpp>
 #include "Card.h"
+#include "ModelCache.h"
 
 // Board class that manages and arranges cards
 // カードを管理・配置するBoardクラス
@@ -14,9 +15,9 @@ class Board
 {
 public:
 
-	// Constructor that initializes the board with card models
-	// カードモデルを使ってボードを初期化するコンストラクタ
-	Board(const char* cardModels[]);
+	// Constructor that initializes the board with card models from the cache
+	// キャッシュのカードモデルを使ってボードを初期化するコンストラクタ
+	Board(ModelCache& modelCache, const char* cardModels[]);
 
 	// Reshuffles cards and resets board state
 	// カードを再シャッフルしボード状態をリセットする
@@ -51,13 +51,17 @@ void Camera::updateMatrix(float FOVdeg, float nearPlane, float farPlane)
 	// 新しいカメラ行列を設定します
 	cameraMatrix = projectionMatrix * viewMatrix;
 
+	// Extract the frustum the new camera matrix sees
+	// 新しいカメラ行列が見る視錐台を抽出する
+	frustum = extract_frustum(cameraMatrix);
+
 }
 
 void Camera::Matrix(Shader& shader, const char* uniform)
 {
 	// Passes the Camera matrix to the shader's uniform variable (Exports the camera matrix)
 	// カメラ行列をシェーダーのユニフォーム変数に渡す（カメラ行列をエクスポートする）
-	glUniformMatrix4fv(glGetUniformLocation(shader.ID, uniform), 1, GL_FALSE, glm::value_ptr(cameraMatrix));
+	shader.SetMat4(uniform, cameraMatrix);
 }
 
 void Camera::Inputs(GLFWwindow* window)
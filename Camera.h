@@ -11,6 +11,7 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include "shaderClass.h"
+#include "Frustum.h"
 
 // Camera class definition
 // カメラクラスの定義
@@ -44,6 +45,10 @@ class Camera
 		// ビュー行列
 		glm::mat4 viewMatrix = glm::mat4(1.0f);
 
+		// Frustum planes extracted from cameraMatrix, used to skip what cannot be seen
+		// 見えないものを飛ばすために使う、cameraMatrixから抽出した視錐台の平面
+		Frustum frustum = extract_frustum(glm::mat4(1.0f));
+
 		// Window dimensions
 		// ウィンドウの幅と高さ
 		int width;
@@ -1,8 +1,9 @@
 #include "Card.h"
 
-// Constructor that loads the model and sets initial orientation
-// モデルを読み込み、初期の向きを設定するコンストラクタ
-Card::Card(const char* modelPath) : model(modelPath)
+// Constructor that stores the shared models and sets initial orientation
+// 共有モデルを保持し、初期の向きを設定するコンストラクタ
+Card::Card(std::shared_ptr<Model> cardModel, std::shared_ptr<Model> placeholderModel, TextureResidency* textureResidency)
+    : model(cardModel), placeholder(placeholderModel), residency(textureResidency)
 {
     // Rotate 90 degrees around Y axis
     // Y軸を中心に90度回転させる
@@ -26,6 +27,19 @@ void Card::Update(float deltaTime)
     // 回転中であれば補間処理を行う
     if (isRotating)
     {
+        // The face can only be shown once its texture is resident: a card turning face up waits at the start,
+        // still showing its back, and a card turning face down whose face is gone finishes turning at once
+        // 表面はテクスチャが常駐してから初めて見せられる。表に返るカードは裏を見せたまま開始位置で待ち、
+        // 表面が失われたまま裏に返るカードはすぐに回転を終える
+        if (residency && !model->IsResident())
+        {
+            residency->Request(model);
+            if (isFaceUp && rotationTimer == 0.0f)
+                return;
+            if (!isFaceUp)
+                rotationTimer = rotationDuration;
+        }
+
         // Increase timer by frame delta time
         // フレームの経過時間をタイマーに加算する
         rotationTimer += deltaTime;
@@ -99,10 +113,33 @@ void Card::Flip()
     isFaceUp = !isFaceUp;
 }
 
+// Requests the face texture before it is needed
+// 必要になる前に表面テクスチャを要求する
+void Card::Prefetch()
+{
+    if (residency)
+        residency->Request(model);
+}
+
+// Lets the face texture be evicted
+// 表面テクスチャを退避させる
+void Card::ReleaseFace()
+{
+    if (residency)
+        residency->Release(model);
+}
+
 // Resets card to default state
 // カードを初期状態に戻す
 void Card::Reset()
 {
+    // Finish a flip still in progress (or still waiting for its face) so the card turns from where it was headed
+    // 進行中（または表面を待っている）フリップを終わらせ、向かっていた向きからカードを返す
+    if (isRotating) {
+        currentOrientation = targetOrientation;
+        isRotating = false;
+    }
+
     // If card is face up, rotate it back
     // 表向きの場合、裏向きに戻す
     if (isFaceUp) {
@@ -121,27 +158,40 @@ void Card::Reset()
     isDestroyed = false;
 }
 
-// Draws the card
-// カードを描画する
-void Card::Draw(Shader& shader, Camera& camera)
+// Picks the model to draw
+// 描画するモデルを選ぶ
+Model* Card::PrepareDraw()
 {
-    // Update shader with current transform
-    // 現在のTransformをシェーダーに渡す
-    shader.Update(transform);
-
-    // Draw model
-    // モデルを描画する
-    model.Draw(shader, camera);
+    // Request the face texture once a flip has started, even while the card still waits showing its back
+    // フリップが始まったら、カードが裏を見せたまま待っている間も表面テクスチャを要求する
+    if ((isFaceUp || isRotating) && residency)
+        residency->Request(model);
+
+    // The face shows while the card is face up or turning, except while a flip waits at its start (see Update)
+    // 表面が見えるのは表向きか回転中のとき（ただしフリップが開始位置で待っている間は除く。Updateを参照）
+    bool faceVisible = isFaceUp ? (!isRotating || rotationTimer > 0.0f) : isRotating;
+
+    // The placeholder is another design, so it may only stand in while the back is what shows;
+    // a face that is not resident is not drawn at all rather than drawn with the wrong art
+    // プレースホルダーは別のデザインのため、代わりにできるのは裏が見えている間のみ
+    // （常駐していない表面は、間違った絵柄で描くのではなく描画しない）
+    if (faceVisible)
+        return model->IsResident() ? model.get() : nullptr;
+
+    // Face down, the placeholder looks the same, so the face texture is not needed
+    // 裏向きの場合はプレースホルダーの見た目が同じため、表面テクスチャは不要
+    if (model->IsResident() && !placeholder)
+        return model.get();
+    return placeholder.get();
 }
 
 // Checks if a ray intersects the card's bounding box
 // レイがカードのバウンディングボックスと交差するか判定する
 bool Card::CheckRayHit(const glm::vec3& rayOrigin, const glm::vec3& rayDir)
 {
-    // Get the model matrix and its inverse
-    // モデル行列とその逆行列を取得する
-    glm::mat4 modelMatrix = transform.GetModel();
-    glm::mat4 invModel = glm::inverse(modelMatrix);
+    // Get the inverse model matrix (cached by the transform until the card moves or turns)
+    // モデル行列の逆行列を取得する（カードが移動または回転するまでTransformがキャッシュする）
+    const glm::mat4& invModel = transform.GetInverseModel();
 
     // Transform the ray into the card's local space
     // レイをカードのローカル空間へ変換する
@@ -1,7 +1,9 @@
 #ifndef CARD_CLASS_H
 #define CARD_CLASS_H
 
+#include <memory>
 #include "Model.h"
+#include "TextureResidency.h"
 
 // Card class representing a playable 3D card object
 // 3Dカードオブジェクトを表すCardクラス
@@ -9,17 +11,22 @@ class Card
 {
 public:
 
-	// Constructor that loads the card model
-	// カードモデルを読み込むコンストラクタ
-	Card(const char* modelPath);
+	// Constructor that takes a shared card model and the placeholder drawn until it is resident
+	// With a residency manager, the model's face texture is only requested while the face can be seen
+	// 共有カードモデルと、それが常駐するまで描画するプレースホルダーを受け取るコンストラクタ
+	// 常駐管理がある場合、モデルの表面テクスチャは表面が見える間のみ要求される
+	Card(std::shared_ptr<Model> cardModel, std::shared_ptr<Model> placeholderModel = nullptr, TextureResidency* textureResidency = nullptr);
 
 	// Updates card state (handles rotation animation)
 	// カードの状態を更新する（回転アニメーション処理）
 	void Update(float deltaTime);
 
-	// Draws the card
-	// カードを描画する
-	void Draw(Shader& shader, Camera& camera);
+	// Returns the model the card is drawn with this frame: the placeholder while the back shows, the card model
+	// once resident, or nullptr while the face shows but is not resident. Also requests the face texture once a
+	// flip has started.
+	// このフレームでカードの描画に使うモデルを返す（裏が見えている間はプレースホルダー、常駐済みならカードモデル、
+	// 表面が見えているのに常駐していない間はnullptr）。フリップが始まると表面テクスチャも要求する
+	Model* PrepareDraw();
 
 	// Half extents of the card's AABB (local space)
 	// カードのAABB半径（ローカル空間）
@@ -49,15 +56,31 @@ public:
 	// カードのフリップアニメーションを開始する
 	void Flip();
 
+	// Starts loading the face texture ahead of a likely flip (e.g. while the cursor is over the card)
+	// フリップされそうなときに表面テクスチャの読み込みを先に始める（例：カーソルがカード上にある間）
+	void Prefetch();
+
+	// Drops the face texture, e.g. once the card has been matched
+	// カードが揃った場合などに、表面テクスチャを手放す
+	void ReleaseFace();
+
 	// Resets the card to initial state
 	// カードを初期状態にリセットする
 	void Reset();
 
 private:
 
-	// 3D model of the card
-	// カードの3Dモデル
-	Model model;
+	// 3D model of the card (shared between cards of the same design)
+	// カードの3Dモデル（同じデザインのカード間で共有される）
+	std::shared_ptr<Model> model;
+
+	// Model drawn while the card model is still streaming (may be nullptr)
+	// カードモデルがストリーミング中の間に描画するモデル（nullptrの場合もある）
+	std::shared_ptr<Model> placeholder;
+
+	// Residency manager for the face texture of the model (may be nullptr)
+	// モデルの表面テクスチャの常駐管理（nullptrの場合もある）
+	TextureResidency* residency;
 
 	// Transform component (position, rotation, scale)
 	// 位置・回転・スケールを管理するTransform
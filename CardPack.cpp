@@ -0,0 +1,85 @@
+#include "CardPack.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+
+// The tables are read straight out of the mapping, so their layout must not depend on the compiler
+// 各表はマッピングから直接読み取るため、レイアウトがコンパイラに依存してはならない
+static_assert(sizeof(CardPackHeader) == 48, "CardPackHeader layout changed");
+static_assert(sizeof(CardPackModel) == 272, "CardPackModel layout changed");
+static_assert(sizeof(CardPackMesh) == 208, "CardPackMesh layout changed");
+static_assert(sizeof(CardPackTexture) == 40, "CardPackTexture layout changed");
+
+void CardPack::Open(const char* file)
+{
+	data.Open(file);
+
+	// Check the header before trusting any offset in it
+	// オフセットを信頼する前にヘッダを確認する
+	if (data.Size() < sizeof(CardPackHeader))
+		throw std::invalid_argument("Card pack is too small");
+
+	const CardPackHeader* packHeader = (const CardPackHeader*)data.Data();
+	if (packHeader->magic != CARD_PACK_MAGIC)
+		throw std::invalid_argument("File is not a card pack");
+	if (packHeader->version != CARD_PACK_VERSION)
+		throw std::invalid_argument("Card pack version is not supported, cook it again");
+
+	header = packHeader;
+	models = (const CardPackModel*)GetData(header->modelsOffset, (uint64_t)header->modelCount * sizeof(CardPackModel));
+	meshes = (const CardPackMesh*)GetData(header->meshesOffset, (uint64_t)header->meshCount * sizeof(CardPackMesh));
+	textures = (const CardPackTexture*)GetData(header->texturesOffset, (uint64_t)header->textureCount * sizeof(CardPackTexture));
+
+	// Index the models by name and check that their ranges stay inside the tables
+	// モデルを名前で索引付けし、範囲が各表の中に収まることを確認する
+	names.clear();
+	for (unsigned int i = 0; i < header->modelCount; i++)
+	{
+		const CardPackModel& model = models[i];
+		if ((uint64_t)model.firstMesh + model.meshCount > header->meshCount ||
+			(uint64_t)model.firstTexture + model.textureCount > header->textureCount)
+			throw std::invalid_argument("Card pack model points outside the tables");
+
+		names[std::string(model.name, strnlen(model.name, sizeof(model.name)))] = i;
+	}
+
+	// Every mesh needs its full level, and every level must stay inside the mesh's indices
+	// すべてのメッシュには完全なレベルが必要で、各レベルはメッシュのインデックス内に収まらなければならない
+	for (unsigned int i = 0; i < header->meshCount; i++)
+	{
+		const CardPackMesh& mesh = meshes[i];
+		if (mesh.lodCount == 0 || mesh.lodCount > CARD_PACK_MAX_LODS)
+			throw std::invalid_argument("Card pack mesh has an invalid number of levels of detail");
+
+		for (unsigned int l = 0; l < mesh.lodCount; l++)
+			if ((uint64_t)mesh.lods[l].firstIndex + mesh.lods[l].indexCount > mesh.indexCount)
+				throw std::invalid_argument("Card pack level of detail points outside the mesh's indices");
+	}
+}
+
+const CardPackModel* CardPack::Find(const char* file) const
+{
+	auto found = names.find(Key(file));
+	return found != names.end() ? &models[found->second] : nullptr;
+}
+
+const unsigned char* CardPack::GetData(uint64_t offset, uint64_t size) const
+{
+	if (offset > data.Size() || size > data.Size() - offset)
+		throw std::out_of_range("Card pack data reaches past the end of the file");
+
+	return data.Data() + offset;
+}
+
+// Lexically normalized path with forward slashes, so "models/./card.gltf" and "models\card.gltf" match
+// スラッシュ区切りで字句的に正規化したパス（"models/./card.gltf"と"models\card.gltf"が一致する）
+std::string CardPack::Key(const char* file)
+{
+	std::string path = file;
+	for (char& c : path)
+		if (c == '\\')
+			c = '/';
+
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
\ No newline at end of file
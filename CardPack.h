@@ -0,0 +1,191 @@
+#ifndef CARD_PACK_CLASS_H
+#define CARD_PACK_CLASS_H
+
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "MappedFile.h"
+
+// File layout of a card pack written by the cardcook tool
+// Header, model table, mesh table and texture table, followed by the raw data they point at.
+// Every offset is in bytes from the start of the file.
+// cardcookツールが書き出すカードパックのファイル構成
+// ヘッダ・モデル表・メッシュ表・テクスチャ表の後に、それらが指す生データが続く
+// オフセットはすべてファイル先頭からのバイト数
+
+// Magic number ("CPAK") and format version
+// マジックナンバー（"CPAK"）とフォーマットのバージョン
+static const uint32_t CARD_PACK_MAGIC = 0x4B415043;
+static const uint32_t CARD_PACK_VERSION = 7;
+
+// Texture types stored in a card pack
+// カードパックに格納されるテクスチャの種類
+static const uint32_t CARD_PACK_DIFFUSE = 0;
+static const uint32_t CARD_PACK_SPECULAR = 1;
+
+struct CardPackHeader
+{
+	uint32_t magic;
+	uint32_t version;
+
+	// Number of entries in each table
+	// 各表のエントリ数
+	uint32_t modelCount;
+	uint32_t meshCount;
+	uint32_t textureCount;
+	uint32_t reserved;
+
+	// Offsets of the tables
+	// 各表のオフセット
+	uint64_t modelsOffset;
+	uint64_t meshesOffset;
+	uint64_t texturesOffset;
+};
+
+// One cooked model, named by the path it was cooked from
+// 1つの調理済みモデル（調理元のパスで名前付けされる）
+struct CardPackModel
+{
+	// Normalized model path (see CardPack::Key)
+	// 正規化されたモデルパス（CardPack::Keyを参照）
+	char name[256];
+
+	// Range of this model's entries in the mesh and texture tables
+	// メッシュ表とテクスチャ表におけるこのモデルのエントリ範囲
+	uint32_t firstMesh;
+	uint32_t meshCount;
+	uint32_t firstTexture;
+	uint32_t textureCount;
+};
+
+// Most levels of detail a cooked mesh can have
+// 調理済みメッシュが持てる詳細度レベルの最大数
+static const uint32_t CARD_PACK_MAX_LODS = 4;
+
+// One level of detail: a range of the mesh's indices
+// 1つの詳細度レベル（メッシュのインデックスの範囲）
+struct CardPackLod
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+
+	// Farthest the level lies from the full mesh, in mesh units, and 1 for a quad impostor
+	// レベルが完全なメッシュから最も離れている距離（メッシュ単位）と、四角形インポスターの場合は1
+	float error;
+	uint32_t impostor;
+};
+
+// One mesh: interleaved vertex data (Vertex or PackedVertex), indices and the node transform
+// 1つのメッシュ：インターリーブされた頂点データ（VertexまたはPackedVertex）・インデックス・ノードの変換
+struct CardPackMesh
+{
+	// Node transform
+	// ノードの変換
+	float matrix[16];
+
+	// Number of vertices and indices, bytes per index (2 or 4) and the VertexFormat of the vertices
+	// 頂点数・インデックス数・1インデックスあたりのバイト数（2または4）・頂点のVertexFormat
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t indexSize;
+	uint32_t vertexFormat;
+
+	// Content hash used to share GPU geometry (same as a glTF load of the model)
+	// GPUジオメトリの共有に使う内容ハッシュ（glTFから読み込んだ場合と同じ）
+	uint64_t hash;
+
+	// Offsets of the vertex and index data
+	// 頂点データとインデックスデータのオフセット
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+
+	// Levels of detail, finest first (the first is the full mesh), the bounding sphere that sizes them on screen
+	// and culls the mesh, and the half size of the bounding box around the same center
+	// 詳細度レベル（細かい順。最初は完全なメッシュ）、画面上の大きさの計測とカリングに使うバウンディング球、
+	// および同じ中心を持つバウンディングボックスの半分の大きさ
+	uint32_t lodCount;
+	float boundsCenter[3];
+	float boundsRadius;
+	float boundsExtents[3];
+	uint32_t padding;
+	CardPackLod lods[CARD_PACK_MAX_LODS];
+};
+
+// One texture stored as a KTX2 file with its full mip chain (block-compressed when cooked from color images)
+// 完全なミップチェーンを持つKTX2ファイルとして格納された1つのテクスチャ（カラー画像から調理した場合はブロック圧縮）
+struct CardPackTexture
+{
+	// CARD_PACK_DIFFUSE or CARD_PACK_SPECULAR
+	// CARD_PACK_DIFFUSEまたはCARD_PACK_SPECULAR
+	uint32_t type;
+
+	// Size of level 0, color channels of the source image, number of mip levels and the KTX2 vkFormat
+	// (for reports; the KTX2 file is what gets uploaded)
+	// レベル0のサイズ・元画像のカラーチャンネル数・ミップレベル数・KTX2のvkFormat
+	// （報告用。転送されるのはKTX2ファイルの内容）
+	uint32_t width;
+	uint32_t height;
+	uint32_t channels;
+	uint32_t mipCount;
+	uint32_t format;
+
+	// Offset and size of the KTX2 file
+	// KTX2ファイルのオフセットとサイズ
+	uint64_t dataOffset;
+	uint64_t dataSize;
+};
+
+// CardPack class that maps a cooked card pack and looks up its models
+// 調理済みカードパックをマッピングし、モデルを検索するCardPackクラス
+class CardPack
+{
+public:
+
+	// Maps the pack file and checks its header and tables
+	// パックファイルをマッピングし、ヘッダと各表を確認する
+	void Open(const char* file);
+
+	// Returns true if a pack is mapped
+	// パックがマッピングされていればtrueを返す
+	inline bool IsOpen() const { return header != nullptr; }
+
+	// Returns the cooked model for the given path, or nullptr if the pack does not have it
+	// 指定されたパスの調理済みモデルを返す（パックに無ければnullptr）
+	const CardPackModel* Find(const char* file) const;
+
+	// Returns an entry of the mesh or texture table
+	// メッシュ表またはテクスチャ表のエントリを返す
+	inline const CardPackMesh& GetMesh(unsigned int i) const { return meshes[i]; }
+	inline const CardPackTexture& GetTexture(unsigned int i) const { return textures[i]; }
+
+	// Returns a pointer to data inside the pack, checking that it lies within the file
+	// パック内のデータへのポインタを返す（ファイル内にあることを確認する）
+	const unsigned char* GetData(uint64_t offset, uint64_t size) const;
+
+	// Returns the size of the mapping (paged in by the OS on demand, so it is not heap memory)
+	// マッピングのサイズを返す（OSが必要に応じて読み込むため、ヒープメモリではない）
+	inline size_t GetMappedBytes() const { return data.Size(); }
+
+	// Normalizes a model path into the name stored in the pack
+	// モデルパスをパックに格納される名前に正規化する
+	static std::string Key(const char* file);
+
+private:
+
+	// The mapped pack file
+	// マッピングされたパックファイル
+	MappedFile data;
+
+	// Header and tables inside the mapping
+	// マッピング内のヘッダと各表
+	const CardPackHeader* header = nullptr;
+	const CardPackModel* models = nullptr;
+	const CardPackMesh* meshes = nullptr;
+	const CardPackTexture* textures = nullptr;
+
+	// Model table index keyed by name
+	// 名前をキーとしたモデル表のインデックス
+	std::unordered_map<std::string, unsigned int> names;
+};
+
+#endif
\ No newline at end of file
@@ -2,15 +2,31 @@
 
 // Constructor: Generates and initializes an Element Buffer Object (EBO)
 // コンストラクタ：エレメントバッファオブジェクト（EBO）を生成し、初期化する
-EBO::EBO(std::vector<GLuint> indices)
+EBO::EBO(const std::vector<GLuint>& indices)
+	: EBO(indices.data(), indices.size() * sizeof(GLuint))
+{
+}
+
+EBO::EBO(const std::vector<GLushort>& indices)
+	: EBO(indices.data(), indices.size() * sizeof(GLushort))
+{
+}
+
+EBO::EBO(const void* indices, GLsizeiptr size)
 {
 	// Generate one buffer object and store its ID
 	// バッファオブジェクトを1つ生成し、そのIDを取得する
-	glGenBuffers(1, &ID);
+	ID = GLBuffer::Create();
+
+	// The element buffer binding is part of the bound VAO, so unbind any VAO first; otherwise creating
+	// the buffer would replace the indices of whichever VAO happened to be bound (e.g. the last one drawn)
+	// エレメントバッファのバインドはバインド中のVAOの状態の一部のため、先にVAOのバインドを解除する
+	// （そうしないと、たまたまバインドされていたVAO（例：最後に描画したもの）のインデックスを置き換えてしまう）
+	GLState::BindVertexArray(0);
 
 	// Bind the buffer as the current GL_ELEMENT_ARRAY_BUFFER
 	// 生成したバッファを GL_ELEMENT_ARRAY_BUFFER としてバインドする
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+	GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
 
 	// Upload index data to GPU memory
 	//
@@ -29,8 +45,8 @@ EBO::EBO(std::vector<GLuint> indices)
 	// 4. 使用パターン（GL_STATIC_DRAW = 頻繁に変更しない）
 	glBufferData(
 		GL_ELEMENT_ARRAY_BUFFER,
-		indices.size() * sizeof(GLuint),
-		indices.data(),
+		size,
+		indices,
 		GL_STATIC_DRAW
 	);
 }
@@ -39,19 +55,19 @@ EBO::EBO(std::vector<GLuint> indices)
 // このEBOをアクティブなインデックスバッファとしてバインドする
 void EBO::Bind()
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+	GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
 }
 
 // Unbind the current element array buffer
 // 現在のインデックスバッファのバインドを解除する
 void EBO::Unbind()
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 // Delete the EBO and free GPU memory
 // EBOを削除し、GPUメモリを解放する
 void EBO::Delete()
 {
-	glDeleteBuffers(1, &ID);
+	ID.Reset();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include<glm/glm.hpp>
 #include<glad/glad.h>
 #include<vector>
+#include"GLHandle.h"
 
 // Element Buffer Object (EBO) class
 // エレメントバッファオブジェクト（EBO）クラス
@@ -13,15 +14,23 @@ class EBO
 {
 public:
 
-	// OpenGL buffer identifier
-	// OpenGLバッファの識別ID
-	GLuint ID;
+	// OpenGL buffer, deleted with the EBO (so EBOs can be moved but not copied)
+	// OpenGLバッファ（EBOと共に削除されるため、EBOはムーブできるがコピーできない）
+	GLBuffer ID;
 
 	// Constructor:
 	// Generates an EBO and uploads index data to GPU memory
 	// コンストラクタ：
 	// EBOを生成し、インデックスデータをGPUメモリに転送する
-	EBO(std::vector<GLuint> indices);
+	EBO(const std::vector<GLuint>& indices);
+
+	// Constructor that uploads 16-bit index data, half the size of 32-bit indices
+	// 16ビットのインデックスデータを転送するコンストラクタ（32ビットの半分のサイズ）
+	EBO(const std::vector<GLushort>& indices);
+
+	// Constructor that uploads size bytes of indices straight from memory (any index type)
+	// メモリからsizeバイトのインデックスを直接転送するコンストラクタ（インデックス型は問わない）
+	EBO(const void* indices, GLsizeiptr size);
 
 	// Bind this EBO as the active GL_ELEMENT_ARRAY_BUFFER
 	// このEBOをGL_ELEMENT_ARRAY_BUFFERとしてバインドする
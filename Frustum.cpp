@@ -0,0 +1,74 @@
+#include "Frustum.h"
+
+Frustum extract_frustum(const glm::mat4& viewProjection)
+{
+	// glm is column-major, so row i of the matrix is element i of every column
+	// glmは列優先のため、行列のi行目は各列のi番目の要素
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+	// A clip-space point is inside when -w <= x, y, z <= w; each inequality is one plane
+	// クリップ空間の点は-w <= x, y, z <= wのとき内側にある（各不等式が1つの平面になる）
+	Frustum frustum;
+	frustum.planes[0] = rows[3] + rows[0];
+	frustum.planes[1] = rows[3] - rows[0];
+	frustum.planes[2] = rows[3] + rows[1];
+	frustum.planes[3] = rows[3] - rows[1];
+	frustum.planes[4] = rows[3] + rows[2];
+	frustum.planes[5] = rows[3] - rows[2];
+
+	// Normalize so the planes give distances that can be compared with a radius
+	// 半径と比較できる距離が得られるよう平面を正規化する
+	for (glm::vec4& plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+
+	return frustum;
+}
+
+void FrustumCuller::Clear()
+{
+	centersX.clear();
+	centersY.clear();
+	centersZ.clear();
+	radii.clear();
+}
+
+size_t FrustumCuller::Add(const glm::vec3& center, float radius)
+{
+	centersX.push_back(center.x);
+	centersY.push_back(center.y);
+	centersZ.push_back(center.z);
+	radii.push_back(radius);
+	return radii.size() - 1;
+}
+
+size_t FrustumCuller::Cull(const Frustum& frustum)
+{
+	size_t count = radii.size();
+	visible.assign(count, 1);
+
+	const float* x = centersX.data();
+	const float* y = centersY.data();
+	const float* z = centersZ.data();
+	const float* r = radii.data();
+	uint8_t* result = visible.data();
+
+	// One plane at a time over every sphere: a sphere is dropped once it lies wholly behind any plane
+	// 1つの平面ずつすべての球を調べる（いずれかの平面の完全に裏側にある球は除かれる）
+	for (const glm::vec4& plane : frustum.planes)
+	{
+		float a = plane.x;
+		float b = plane.y;
+		float c = plane.z;
+		float d = plane.w;
+		for (size_t i = 0; i < count; i++)
+			result[i] &= (uint8_t)(a * x[i] + b * y[i] + c * z[i] + d >= -r[i]);
+	}
+
+	visibleCount = 0;
+	for (size_t i = 0; i < count; i++)
+		visibleCount += result[i];
+	culledCount = count - visibleCount;
+	return visibleCount;
+}
\ No newline at end of file
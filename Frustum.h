@@ -0,0 +1,71 @@
+#ifndef FRUSTUM_CLASS_H
+#define FRUSTUM_CLASS_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Planes of a view frustum (left, right, bottom, top, near, far), each a normal pointing inside and a distance,
+// normalized so a point's signed distance to a plane is dot(plane.xyz, point) + plane.w
+// 視錐台の平面（左・右・下・上・近・遠）。それぞれ内側を向く法線と距離からなり、点から平面までの
+// 符号付き距離がdot(plane.xyz, point) + plane.wになるよう正規化されている
+struct Frustum
+{
+	glm::vec4 planes[6];
+};
+
+// Extracts the frustum planes from a projection * view matrix (Gribb and Hartmann)
+// 投影行列×ビュー行列から視錐台の平面を抽出する（GribbとHartmannの方法）
+Frustum extract_frustum(const glm::mat4& viewProjection);
+
+// FrustumCuller class that tests a batch of bounding spheres against a frustum in one pass
+// The spheres are kept as separate arrays of x, y, z and radius so the test over them is a plain loop
+// of multiply-adds the compiler can vectorize, with no branch per sphere.
+// バウンディング球のまとまりを1回の走査で視錐台に対して判定するFrustumCullerクラス
+// 球はx・y・z・半径の別々の配列として保持するため、判定は球ごとの分岐が無く、
+// コンパイラがベクトル化できる単純な積和のループになる
+class FrustumCuller
+{
+public:
+
+	// Forgets the spheres added so far (the counts of the last Cull stay until the next one)
+	// これまでに追加した球を忘れる（直前のCullの数は次のCullまで残る）
+	void Clear();
+
+	// Adds a world-space sphere and returns its index for IsVisible
+	// ワールド空間の球を追加し、IsVisible用のインデックスを返す
+	size_t Add(const glm::vec3& center, float radius);
+
+	// Tests every sphere against the frustum and returns how many touch it
+	// すべての球を視錐台に対して判定し、視錐台に触れる球の数を返す
+	size_t Cull(const Frustum& frustum);
+
+	// Returns true if the sphere at index touched the frustum in the last Cull
+	// 直前のCullでインデックスの球が視錐台に触れていればtrueを返す
+	inline bool IsVisible(size_t index) const { return visible[index] != 0; }
+
+	// Returns how many spheres the last Cull kept and dropped
+	// 直前のCullで残した球と除いた球の数を返す
+	inline size_t GetVisibleCount() const { return visibleCount; }
+	inline size_t GetCulledCount() const { return culledCount; }
+
+private:
+
+	// Sphere centers and radii, one array per component
+	// 球の中心と半径（成分ごとに1つの配列）
+	std::vector<float> centersX;
+	std::vector<float> centersY;
+	std::vector<float> centersZ;
+	std::vector<float> radii;
+
+	// Result of the last Cull per sphere (1 if it touches the frustum)
+	// 直前のCullの球ごとの結果（視錐台に触れていれば1）
+	std::vector<uint8_t> visible;
+
+	// Counts of the last Cull
+	// 直前のCullの数
+	size_t visibleCount = 0;
+	size_t culledCount = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef GL_HANDLE_CLASS_H
+#define GL_HANDLE_CLASS_H
+
+#include <glad/glad.h>
+#include "GLState.h"
+
+// GLHandle class that owns one OpenGL object name and deletes it when destroyed
+// Handles can be moved but not copied, so every GL object has exactly one owner and nothing leaks
+// or is deleted twice. Traits supplies the create and delete calls (see the typedefs below).
+// 1つのOpenGLオブジェクト名を所有し、破棄時に削除するGLHandleクラス
+// ハンドルはムーブできるがコピーできないため、すべてのGLオブジェクトの所有者は常に1つで、
+// リークも二重削除も起こらない。Traitsが作成・削除の呼び出しを提供する（下のtypedefを参照）
+template <typename Traits>
+class GLHandle
+{
+public:
+
+	// Constructor that creates an empty handle
+	// 空のハンドルを作成するコンストラクタ
+	GLHandle() = default;
+
+	// Constructor that takes ownership of an existing name (0 makes an empty handle)
+	// 既存の名前の所有権を受け取るコンストラクタ（0の場合は空のハンドル）
+	explicit GLHandle(GLuint name)
+		: name(name)
+	{
+		if (name)
+			live++;
+	}
+
+	// Creates a new GL object (call with a current GL context)
+	// 新しいGLオブジェクトを作成する（GLコンテキストが有効な状態で呼ぶ）
+	static GLHandle Create() { return GLHandle(Traits::Create()); }
+
+	// Destructor that deletes the object, so the context must still be alive
+	// オブジェクトを削除するデストラクタ（コンテキストがまだ生存していなければならない）
+	~GLHandle() { Reset(); }
+
+	// Ownership can be moved, never shared
+	// 所有権はムーブできるが、共有はできない
+	GLHandle(const GLHandle&) = delete;
+	GLHandle& operator=(const GLHandle&) = delete;
+
+	GLHandle(GLHandle&& other) noexcept
+		: name(other.name)
+	{
+		other.name = 0;
+	}
+
+	GLHandle& operator=(GLHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			name = other.name;
+			other.name = 0;
+		}
+		return *this;
+	}
+
+	// Deletes the object now, leaving the handle empty
+	// オブジェクトを今すぐ削除し、ハンドルを空にする
+	void Reset()
+	{
+		if (name)
+		{
+			Traits::Delete(name);
+			live--;
+			name = 0;
+		}
+	}
+
+	// Returns the GL name (0 if empty); handles also convert to GLuint so they can be passed to GL calls
+	// GLの名前を返す（空の場合は0）。ハンドルはGLの呼び出しに渡せるようGLuintにも変換できる
+	inline GLuint Get() const { return name; }
+	inline operator GLuint() const { return name; }
+
+	// Returns the number of objects of this kind that are alive
+	// 生存しているこの種類のオブジェクトの数を返す
+	static inline unsigned int GetLiveCount() { return live; }
+
+private:
+
+	// Name of the owned object
+	// 所有するオブジェクトの名前
+	GLuint name = 0;
+
+	// Live objects of this kind, for leak checks
+	// リーク確認用の、生存しているこの種類のオブジェクト数
+	static inline unsigned int live = 0;
+};
+
+// Create and delete calls of each kind of GL object
+// GLオブジェクトの種類ごとの作成・削除の呼び出し
+struct GLBufferTraits
+{
+	static GLuint Create() { GLuint name; glGenBuffers(1, &name); return name; }
+	static void Delete(GLuint name) { GLState::OnBufferDeleted(name); glDeleteBuffers(1, &name); }
+};
+
+struct GLVertexArrayTraits
+{
+	static GLuint Create() { GLuint name; glGenVertexArrays(1, &name); return name; }
+	static void Delete(GLuint name) { GLState::OnVertexArrayDeleted(name); glDeleteVertexArrays(1, &name); }
+};
+
+struct GLTextureTraits
+{
+	static GLuint Create() { GLuint name; glGenTextures(1, &name); return name; }
+	static void Delete(GLuint name) { GLState::OnTextureDeleted(name); glDeleteTextures(1, &name); }
+};
+
+struct GLProgramTraits
+{
+	static GLuint Create() { return glCreateProgram(); }
+	static void Delete(GLuint name) { GLState::OnProgramDeleted(name); glDeleteProgram(name); }
+};
+
+typedef GLHandle<GLBufferTraits> GLBuffer;
+typedef GLHandle<GLVertexArrayTraits> GLVertexArray;
+typedef GLHandle<GLTextureTraits> GLTexture;
+typedef GLHandle<GLProgramTraits> GLProgram;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "GLState.h"
+
+bool GLState::unchanged(GLuint& cached, GLuint value)
+{
+	if (cached == value)
+	{
+		frame.skipped++;
+		return true;
+	}
+
+	cached = value;
+	frame.issued++;
+	return false;
+}
+
+void GLState::UseProgram(GLuint program)
+{
+	if (!unchanged(GLState::program, program))
+		glUseProgram(program);
+}
+
+void GLState::BindVertexArray(GLuint vertexArray)
+{
+	if (unchanged(GLState::vertexArray, vertexArray))
+		return;
+
+	glBindVertexArray(vertexArray);
+	buffers[ELEMENT_BUFFER] = UNKNOWN;
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer)
+{
+	BufferTarget index;
+	switch (target)
+	{
+	case GL_ARRAY_BUFFER: index = ARRAY_BUFFER; break;
+	case GL_ELEMENT_ARRAY_BUFFER: index = ELEMENT_BUFFER; break;
+	case GL_UNIFORM_BUFFER: index = UNIFORM_BUFFER; break;
+	case GL_PIXEL_UNPACK_BUFFER: index = PIXEL_UNPACK_BUFFER; break;
+	default:
+		frame.issued++;
+		glBindBuffer(target, buffer);
+		return;
+	}
+
+	if (!unchanged(buffers[index], buffer))
+		glBindBuffer(target, buffer);
+}
+
+void GLState::BindUniformBuffer(GLuint index, GLuint buffer)
+{
+	if (index >= MAX_UNIFORM_BINDINGS)
+		frame.issued++;
+	else if (unchanged(uniformBindings[index], buffer))
+		return;
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+	buffers[UNIFORM_BUFFER] = buffer;
+}
+
+void GLState::activeTexture(GLuint unit)
+{
+	if (!unchanged(activeUnit, unit))
+		glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::BindTexture(GLuint unit, GLenum target, GLuint texture)
+{
+	unsigned int slot = target == GL_TEXTURE_2D_ARRAY ? TEXTURE_2D_ARRAY : TEXTURE_2D;
+	if (unit >= MAX_TEXTURE_UNITS)
+	{
+		activeTexture(unit);
+		frame.issued++;
+		glBindTexture(target, texture);
+		return;
+	}
+
+	// Already bound on that unit: neither the unit nor the texture needs to change
+	// そのユニットに既にバインドされている場合、ユニットもテクスチャも変える必要は無い
+	if (textures[unit][slot] == texture)
+	{
+		frame.skipped++;
+		return;
+	}
+
+	activeTexture(unit);
+	unchanged(textures[unit][slot], texture);
+	glBindTexture(target, texture);
+}
+
+void GLState::BindTexture(GLenum target, GLuint texture)
+{
+	// With the active unit unknown, bind through unit 0 so the mirror stays exact
+	// アクティブユニットが不明な場合、写しを正確に保つためユニット0を通してバインドする
+	if (activeUnit == UNKNOWN)
+		activeTexture(0);
+	BindTexture(activeUnit, target, texture);
+}
+
+void GLState::OnBufferDeleted(GLuint buffer)
+{
+	for (GLuint& bound : buffers)
+		if (bound == buffer)
+			bound = UNKNOWN;
+	for (GLuint& bound : uniformBindings)
+		if (bound == buffer)
+			bound = UNKNOWN;
+}
+
+void GLState::OnVertexArrayDeleted(GLuint vertexArray)
+{
+	if (GLState::vertexArray == vertexArray)
+	{
+		GLState::vertexArray = UNKNOWN;
+		buffers[ELEMENT_BUFFER] = UNKNOWN;
+	}
+}
+
+void GLState::OnTextureDeleted(GLuint texture)
+{
+	for (auto& unit : textures)
+		for (GLuint& bound : unit)
+			if (bound == texture)
+				bound = UNKNOWN;
+}
+
+void GLState::OnProgramDeleted(GLuint program)
+{
+	if (GLState::program == program)
+		GLState::program = UNKNOWN;
+}
+
+void GLState::Invalidate()
+{
+	program = UNKNOWN;
+	vertexArray = UNKNOWN;
+	activeUnit = UNKNOWN;
+	for (GLuint& bound : buffers)
+		bound = UNKNOWN;
+	for (GLuint& bound : uniformBindings)
+		bound = UNKNOWN;
+	for (auto& unit : textures)
+		for (GLuint& bound : unit)
+			bound = UNKNOWN;
+}
+
+void GLState::EndFrame()
+{
+	lastFrame = frame;
+	frame = {};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef GL_STATE_CLASS_H
+#define GL_STATE_CLASS_H
+
+#include <glad/glad.h>
+
+// GLState class that mirrors the bindings of the GL context so calls that would change nothing are skipped
+// Every program, vertex array, buffer and texture bind in the game goes through here; a bind made behind its
+// back would leave the mirror wrong, so new code must use it too (or call Invalidate afterwards).
+// Issued and skipped calls are counted per frame.
+// GLコンテキストのバインド状態を写し、何も変えない呼び出しを省くGLStateクラス
+// ゲーム内のプログラム・頂点配列・バッファ・テクスチャのバインドはすべてここを通る。ここを通さずにバインドすると
+// 写しが正しくなくなるため、新しいコードもこれを使わなければならない（または後でInvalidateを呼ぶ）
+// 発行した呼び出しと省いた呼び出しはフレームごとに数える
+class GLState
+{
+public:
+
+	// Calls issued to the driver and calls skipped because the state was already current
+	// ドライバに発行した呼び出しと、状態が既に一致していたため省いた呼び出し
+	struct Counters
+	{
+		unsigned int issued;
+		unsigned int skipped;
+	};
+
+	// glUseProgram
+	static void UseProgram(GLuint program);
+
+	// glBindVertexArray (the element array binding belongs to the vertex array, so it is forgotten on a change)
+	// glBindVertexArray（エレメント配列のバインドは頂点配列に属するため、変更時に忘れる）
+	static void BindVertexArray(GLuint vertexArray);
+
+	// glBindBuffer; targets other than array, element array, uniform and pixel unpack buffers are always issued
+	// glBindBuffer（配列・エレメント配列・uniform・ピクセルアンパック以外のターゲットは常に発行する）
+	static void BindBuffer(GLenum target, GLuint buffer);
+
+	// glBindBufferBase for uniform blocks (which also binds the generic GL_UNIFORM_BUFFER target)
+	// uniformブロック用のglBindBufferBase（汎用のGL_UNIFORM_BUFFERターゲットもバインドする）
+	static void BindUniformBuffer(GLuint index, GLuint buffer);
+
+	// Binds a 2D or 2D array texture to a unit, making it the active unit only if the texture must change
+	// 2Dまたは2D配列テクスチャをユニットにバインドする（テクスチャの変更が必要な場合のみアクティブユニットを切り替える）
+	static void BindTexture(GLuint unit, GLenum target, GLuint texture);
+
+	// Binds a texture to the active unit, e.g. to upload to it
+	// アクティブユニットにテクスチャをバインドする（例：転送のため）
+	static void BindTexture(GLenum target, GLuint texture);
+
+	// Called by the GL handles when an object is deleted, since GL unbinds it and may reuse its name
+	// オブジェクトの削除時にGLハンドルから呼ばれる（GLはバインドを解除し、名前を再利用する場合があるため）
+	static void OnBufferDeleted(GLuint buffer);
+	static void OnVertexArrayDeleted(GLuint vertexArray);
+	static void OnTextureDeleted(GLuint texture);
+	static void OnProgramDeleted(GLuint program);
+
+	// Forgets every binding, so the next call of each kind is issued (e.g. after code that binds on its own)
+	// すべてのバインドを忘れ、各種類の次の呼び出しを発行させる（例：独自にバインドするコードの後）
+	static void Invalidate();
+
+	// Finishes the frame's counters (call once per frame)
+	// フレームの計数を締める（毎フレーム1回呼ぶ）
+	static void EndFrame();
+
+	// Returns the counters of the last finished frame
+	// 最後に締めたフレームの計数を返す
+	static inline Counters GetFrameCounters() { return lastFrame; }
+
+private:
+
+	// Value of a binding that is not known (never a GL name)
+	// 不明なバインドの値（GLの名前にはならない）
+	static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+	// Texture units and uniform binding points that are mirrored (higher ones are always issued)
+	// 写すテクスチャユニットとuniformバインディングポイント（それ以上は常に発行する）
+	static const unsigned int MAX_TEXTURE_UNITS = 16;
+	static const unsigned int MAX_UNIFORM_BINDINGS = 16;
+
+	// Mirrored buffer targets, and texture targets per unit
+	// 写すバッファのターゲットと、ユニットごとのテクスチャのターゲット
+	enum BufferTarget { ARRAY_BUFFER, ELEMENT_BUFFER, UNIFORM_BUFFER, PIXEL_UNPACK_BUFFER, BUFFER_TARGET_COUNT };
+	enum TextureTarget { TEXTURE_2D, TEXTURE_2D_ARRAY, TEXTURE_TARGET_COUNT };
+
+	// Mirrored bindings; a new context starts with nothing bound and texture unit 0 active
+	// 写したバインド（新しいコンテキストは何もバインドされておらず、テクスチャユニット0がアクティブな状態で始まる）
+	static inline GLuint program = 0;
+	static inline GLuint vertexArray = 0;
+	static inline GLuint buffers[BUFFER_TARGET_COUNT] = {};
+	static inline GLuint uniformBindings[MAX_UNIFORM_BINDINGS] = {};
+	static inline GLuint activeUnit = 0;
+	static inline GLuint textures[MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT] = {};
+
+	// Counters of the frame in progress and of the last finished one
+	// 進行中のフレームと最後に締めたフレームの計数
+	static inline Counters frame = {};
+	static inline Counters lastFrame = {};
+
+	// Sets the active texture unit
+	// アクティブなテクスチャユニットを設定する
+	static void activeTexture(GLuint unit);
+
+	// Returns true (counting a skip) if cached already holds value, otherwise stores value and counts an issue
+	// cachedが既にvalueを保持していればtrueを返し（省略として数える）、そうでなければvalueを記録して発行として数える
+	static bool unchanged(GLuint& cached, GLuint value);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "GLTFDocument.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <json/json.h>
+#include <glm/gtc/type_ptr.hpp>
+
+// Alias nlohmann::json to json for convenience
+// 利便性のために nlohmann::json を json という別名で使用する
+using json = nlohmann::json;
+
+// Returns the size in bytes of one accessor element
+// アクセサ1要素のバイトサイズを返す
+unsigned int GLTFAccessor::ElementSize() const
+{
+	// Bytes per component for the glTF component type
+	// glTFのコンポーネント型ごとのバイト数
+	unsigned int componentSize;
+	if (componentType == 5120 || componentType == 5121) componentSize = 1;
+	else if (componentType == 5122 || componentType == 5123) componentSize = 2;
+	else componentSize = 4;
+
+	return componentSize * numComponents;
+}
+
+// Reads a fixed number of floats from a JSON array
+// JSON配列から決まった数のfloatを読み取る
+static void readFloats(const json& array, float* values, unsigned int count)
+{
+	for (unsigned int i = 0; i < count && i < array.size(); i++)
+		values[i] = array[i];
+}
+
+GLTFDocument::GLTFDocument(const std::string& text)
+	: GLTFDocument(text.data(), text.size())
+{
+}
+
+// Binary glTF header magic ("glTF") and chunk types ("JSON" and "BIN\0")
+// バイナリglTFヘッダのマジック（"glTF"）とチャンク型（"JSON"と"BIN\0"）
+static const uint32_t GLB_MAGIC = 0x46546C67;
+static const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+static const uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+// Reads a little-endian 32-bit value
+// リトルエンディアンの32ビット値を読み取る
+static uint32_t readUint32(const unsigned char* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+bool GLTFDocument::IsGLB(const unsigned char* bytes, size_t size)
+{
+	return size >= 12 && readUint32(bytes) == GLB_MAGIC;
+}
+
+GLBChunks GLTFDocument::ReadGLB(const unsigned char* bytes, size_t size)
+{
+	// 12-byte header: magic, version, total length
+	// 12バイトのヘッダ：マジック・バージョン・全体の長さ
+	if (!IsGLB(bytes, size))
+		throw std::invalid_argument("File is not a binary glTF container");
+	if (readUint32(bytes + 4) != 2)
+		throw std::invalid_argument("Only binary glTF version 2 is supported");
+
+	size_t length = readUint32(bytes + 8);
+	if (length > size)
+		throw std::invalid_argument("Binary glTF container is truncated");
+
+	// Walk the chunks, each prefixed by its length and type
+	// 長さと型が前置された各チャンクを順にたどる
+	GLBChunks chunks;
+	size_t offset = 12;
+	while (offset + 8 <= length)
+	{
+		size_t chunkLength = readUint32(bytes + offset);
+		uint32_t chunkType = readUint32(bytes + offset + 4);
+		const unsigned char* chunkData = bytes + offset + 8;
+
+		if (offset + 8 + chunkLength > length)
+			throw std::invalid_argument("Binary glTF chunk runs past the end of the file");
+
+		if (chunkType == GLB_CHUNK_JSON && chunks.json == nullptr)
+		{
+			chunks.json = (const char*)chunkData;
+			chunks.jsonSize = chunkLength;
+		}
+		else if (chunkType == GLB_CHUNK_BIN && chunks.bin == nullptr)
+		{
+			chunks.bin = chunkData;
+			chunks.binSize = chunkLength;
+		}
+
+		// Unknown chunks are skipped as the specification requires
+		// 仕様に従い、未知のチャンクは読み飛ばす
+		offset += 8 + chunkLength;
+	}
+
+	if (chunks.json == nullptr)
+		throw std::invalid_argument("Binary glTF container has no JSON chunk");
+
+	return chunks;
+}
+
+GLTFDocument::GLTFDocument(const char* text, size_t size)
+{
+	// Parse the JSON once; every lookup below walks it a single time
+	// JSONを一度だけ解析する（以下の参照はそれぞれ一度だけ走査する）
+	json JSON = json::parse(text, text + size);
+
+	// Nodes and their local transforms
+	// ノードとそのローカル変換
+	for (const json& node : JSON.value("nodes", json::array()))
+	{
+		GLTFNode parsed;
+		parsed.mesh = node.value("mesh", -1);
+
+		if (node.contains("children"))
+			for (const json& child : node["children"])
+				parsed.children.push_back(child);
+
+		if (node.contains("translation"))
+			readFloats(node["translation"], glm::value_ptr(parsed.translation), 3);
+
+		// glTF stores quaternion as (x, y, z, w), but glm expects (w, x, y, z)
+		// glTFは(x, y, z, w)形式、glmは(w, x, y, z)形式を使用する
+		if (node.contains("rotation"))
+		{
+			float rotValues[4] =
+			{
+				node["rotation"][3],
+				node["rotation"][0],
+				node["rotation"][1],
+				node["rotation"][2],
+			};
+			parsed.rotation = glm::make_quat(rotValues);
+		}
+
+		if (node.contains("scale"))
+			readFloats(node["scale"], glm::value_ptr(parsed.scale), 3);
+
+		if (node.contains("matrix"))
+		{
+			float matValues[16];
+			readFloats(node["matrix"], matValues, 16);
+			parsed.matrix = glm::make_mat4(matValues);
+		}
+
+		nodes.push_back(parsed);
+	}
+
+	// Meshes and the accessors each primitive uses
+	// メッシュと各プリミティブが使用するアクセサ
+	for (const json& mesh : JSON.value("meshes", json::array()))
+	{
+		GLTFMesh parsed;
+		for (const json& primitive : mesh["primitives"])
+		{
+			GLTFPrimitive parsedPrimitive;
+			const json& attributes = primitive["attributes"];
+			parsedPrimitive.position = attributes.value("POSITION", -1);
+			parsedPrimitive.normal = attributes.value("NORMAL", -1);
+			parsedPrimitive.texCoord0 = attributes.value("TEXCOORD_0", -1);
+			parsedPrimitive.indices = primitive.value("indices", -1);
+			parsedPrimitive.material = primitive.value("material", -1);
+			parsed.primitives.push_back(parsedPrimitive);
+		}
+		meshes.push_back(parsed);
+	}
+
+	// Accessors with their element layout resolved to numbers
+	// 要素レイアウトを数値に変換したアクセサ
+	for (const json& accessor : JSON.value("accessors", json::array()))
+	{
+		GLTFAccessor parsed;
+		parsed.bufferView = accessor.value("bufferView", -1);
+		parsed.byteOffset = accessor.value("byteOffset", 0u);
+		parsed.count = accessor["count"];
+		parsed.componentType = accessor["componentType"];
+
+		// Determine how many components make up one element
+		// 1要素あたりのコンポーネント数を決定する
+		std::string type = accessor["type"];
+		if (type == "SCALAR") parsed.numComponents = 1;
+		else if (type == "VEC2") parsed.numComponents = 2;
+		else if (type == "VEC3") parsed.numComponents = 3;
+		else if (type == "VEC4") parsed.numComponents = 4;
+		else if (type == "MAT4") parsed.numComponents = 16;
+		else throw std::invalid_argument("Type is invalid (not SCALAR, VEC2, VEC3, VEC4, or MAT4");
+
+		if (accessor.contains("min"))
+			parsed.min = accessor["min"].get<std::vector<float>>();
+		if (accessor.contains("max"))
+			parsed.max = accessor["max"].get<std::vector<float>>();
+
+		accessors.push_back(parsed);
+	}
+
+	// Buffer views
+	// バッファビュー
+	for (const json& bufferView : JSON.value("bufferViews", json::array()))
+	{
+		GLTFBufferView parsed;
+		parsed.buffer = bufferView.value("buffer", 0);
+		parsed.byteOffset = bufferView.value("byteOffset", 0u);
+		parsed.byteLength = bufferView.value("byteLength", 0u);
+		parsed.byteStride = bufferView.value("byteStride", 0u);
+		bufferViews.push_back(parsed);
+	}
+
+	// Buffers
+	// バッファ
+	for (const json& buffer : JSON.value("buffers", json::array()))
+	{
+		GLTFBuffer parsed;
+		parsed.uri = buffer.value("uri", "");
+		parsed.byteLength = buffer.value("byteLength", 0u);
+		buffers.push_back(parsed);
+	}
+
+	// Images
+	// 画像
+	for (const json& image : JSON.value("images", json::array()))
+	{
+		GLTFImage parsed;
+		parsed.uri = image.value("uri", "");
+		parsed.bufferView = image.value("bufferView", -1);
+		parsed.mimeType = image.value("mimeType", "");
+		images.push_back(parsed);
+	}
+
+	// Textures
+	// テクスチャ
+	for (const json& texture : JSON.value("textures", json::array()))
+	{
+		GLTFTexture parsed;
+		parsed.source = texture.value("source", -1);
+		textures.push_back(parsed);
+	}
+
+	// Materials (only the texture slots the renderer uses)
+	// マテリアル（レンダラーが使用するテクスチャスロットのみ）
+	for (const json& material : JSON.value("materials", json::array()))
+	{
+		GLTFMaterial parsed;
+		if (material.contains("pbrMetallicRoughness"))
+		{
+			const json& pbr = material["pbrMetallicRoughness"];
+			if (pbr.contains("baseColorTexture"))
+				parsed.baseColorTexture = pbr["baseColorTexture"].value("index", -1);
+			if (pbr.contains("metallicRoughnessTexture"))
+				parsed.metallicRoughnessTexture = pbr["metallicRoughnessTexture"].value("index", -1);
+		}
+		materials.push_back(parsed);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#ifndef GLTF_DOCUMENT_CLASS_H
+#define GLTF_DOCUMENT_CLASS_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Scene graph node with its local transform
+// ローカル変換を持つシーングラフのノード
+struct GLTFNode
+{
+	// Index of the mesh drawn by this node (-1 if none)
+	// このノードが描画するメッシュのインデックス（無い場合は-1）
+	int mesh = -1;
+
+	// Indices of the child nodes
+	// 子ノードのインデックス
+	std::vector<int> children;
+
+	// Local translation, rotation and scale
+	// ローカルの平行移動・回転・拡大縮小
+	glm::vec3 translation = glm::vec3(0.0f, 0.0f, 0.0f);
+	glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	glm::vec3 scale = glm::vec3(1.0f, 1.0f, 1.0f);
+
+	// Full local matrix (identity unless the node specifies one)
+	// 完全なローカル行列（ノードが指定しない限り単位行列）
+	glm::mat4 matrix = glm::mat4(1.0f);
+};
+
+// Drawable part of a mesh, referencing its accessors by index
+// アクセサをインデックスで参照する、メッシュの描画単位
+struct GLTFPrimitive
+{
+	// Accessor indices of the vertex attributes (-1 if missing)
+	// 頂点属性のアクセサインデックス（無い場合は-1）
+	int position = -1;
+	int normal = -1;
+	int texCoord0 = -1;
+
+	// Accessor index of the index data (-1 for non-indexed primitives)
+	// インデックスデータのアクセサインデックス（インデックス無しの場合は-1）
+	int indices = -1;
+
+	// Material index (-1 if none)
+	// マテリアルのインデックス（無い場合は-1）
+	int material = -1;
+};
+
+// Mesh made of one or more primitives
+// 1つ以上のプリミティブで構成されるメッシュ
+struct GLTFMesh
+{
+	std::vector<GLTFPrimitive> primitives;
+};
+
+// Typed window into a buffer view
+// バッファビューへの型付きの窓
+struct GLTFAccessor
+{
+	// Index of the buffer view holding the data (-1 if none)
+	// データを保持するバッファビューのインデックス（無い場合は-1）
+	int bufferView = -1;
+
+	// Offset of the first element inside the buffer view
+	// バッファビュー内の最初の要素のオフセット
+	unsigned int byteOffset = 0;
+
+	// Number of elements
+	// 要素数
+	unsigned int count = 0;
+
+	// glTF component type (5120-5126)
+	// glTFのコンポーネント型（5120〜5126）
+	unsigned int componentType = 0;
+
+	// Components per element (1 for SCALAR up to 4 for VEC4)
+	// 1要素あたりのコンポーネント数（SCALARの1からVEC4の4まで）
+	unsigned int numComponents = 0;
+
+	// Per-component bounds (empty if the file does not store them)
+	// コンポーネントごとの範囲（ファイルに無い場合は空）
+	std::vector<float> min;
+	std::vector<float> max;
+
+	// Returns the size in bytes of one element
+	// 1要素のバイトサイズを返す
+	unsigned int ElementSize() const;
+};
+
+// Slice of a buffer
+// バッファの一部分
+struct GLTFBufferView
+{
+	int buffer = 0;
+	unsigned int byteOffset = 0;
+	unsigned int byteLength = 0;
+
+	// Distance between elements (0 means tightly packed)
+	// 要素間の距離（0は詰めて配置されていることを意味する）
+	unsigned int byteStride = 0;
+};
+
+// Binary buffer referenced by the file
+// ファイルから参照されるバイナリバッファ
+struct GLTFBuffer
+{
+	// URI relative to the model file (empty for embedded buffers)
+	// モデルファイルからの相対URI（埋め込みバッファの場合は空）
+	std::string uri;
+	unsigned int byteLength = 0;
+};
+
+// Image, either an external file or a buffer view
+// 外部ファイルまたはバッファビューの画像
+struct GLTFImage
+{
+	std::string uri;
+	int bufferView = -1;
+	std::string mimeType;
+};
+
+// Texture pointing at an image
+// 画像を指すテクスチャ
+struct GLTFTexture
+{
+	int source = -1;
+};
+
+// Material with the texture slots the renderer uses
+// レンダラーが使用するテクスチャスロットを持つマテリアル
+struct GLTFMaterial
+{
+	// Texture indices (-1 if unused)
+	// テクスチャのインデックス（未使用の場合は-1）
+	int baseColorTexture = -1;
+	int metallicRoughnessTexture = -1;
+};
+
+// JSON and BIN chunks located inside a binary glTF (.glb) container
+// バイナリglTF（.glb）コンテナ内のJSONチャンクとBINチャンクの位置
+struct GLBChunks
+{
+	// JSON text of the container
+	// コンテナのJSONテキスト
+	const char* json = nullptr;
+	size_t jsonSize = 0;
+
+	// Embedded binary buffer (nullptr if the container has none)
+	// 埋め込みバイナリバッファ（無い場合はnullptr）
+	const unsigned char* bin = nullptr;
+	size_t binSize = 0;
+};
+
+// GLTFDocument class that parses glTF JSON once into plain structs with index references
+// glTFのJSONを一度だけ解析し、インデックス参照を持つ単純な構造体に変換するGLTFDocumentクラス
+class GLTFDocument
+{
+public:
+
+	std::vector<GLTFNode> nodes;
+	std::vector<GLTFMesh> meshes;
+	std::vector<GLTFAccessor> accessors;
+	std::vector<GLTFBufferView> bufferViews;
+	std::vector<GLTFBuffer> buffers;
+	std::vector<GLTFImage> images;
+	std::vector<GLTFTexture> textures;
+	std::vector<GLTFMaterial> materials;
+
+	// Constructor that creates an empty document
+	// 空のドキュメントを作成するコンストラクタ
+	GLTFDocument() = default;
+
+	// Constructor that parses the JSON text of a glTF file
+	// glTFファイルのJSONテキストを解析するコンストラクタ
+	GLTFDocument(const std::string& text);
+
+	// Constructor that parses JSON text in place (e.g. straight from a mapped file)
+	// JSONテキストをその場で解析するコンストラクタ（例：マッピングされたファイルから直接）
+	GLTFDocument(const char* text, size_t size);
+
+	// Returns true if the bytes start with the binary glTF magic number
+	// バイト列がバイナリglTFのマジックナンバーで始まる場合trueを返す
+	static bool IsGLB(const unsigned char* bytes, size_t size);
+
+	// Locates the JSON and BIN chunks of a binary glTF container without copying them
+	// バイナリglTFコンテナのJSONチャンクとBINチャンクをコピーせずに見つける
+	static GLBChunks ReadGLB(const unsigned char* bytes, size_t size);
+};
+
+#endif
\ No newline at end of file
@@ -10,7 +10,7 @@ GameLogic::GameLogic(Board& board, MousePicker& mousepicker, Camera& cam)
 
 // Main game update loop
 // ゲームのメイン更新処理
-void GameLogic::Update(Shader shaderProgram, float deltaTime, GLFWwindow* window)
+void GameLogic::Update(Shader& shaderProgram, float deltaTime, GLFWwindow* window)
 {
 	// Get ray origin from camera position
 	// カメラ位置からレイの始点を取得する
@@ -51,14 +51,19 @@ void GameLogic::Update(Shader shaderProgram, float deltaTime, GLFWwindow* window
 		// レイがこのカードに当たった場合
 		if (gameBoard.getCards()[i].CheckRayHit(rayOrigin, rayDir))
 		{
+			// Compute mirrored index (temporary fix for AABB issue)
+			// AABBの不具合による暫定的なミラーインデックス計算
+			int oppositeIndex = totalCards - 1 - i;
+
+			// A hovered card is likely to be flipped next, so start loading its face
+			// カーソルが乗ったカードは次にフリップされやすいため、表面の読み込みを始める
+			if (!gameBoard.getCards()[oppositeIndex].isDestroyed)
+				gameBoard.getCards()[oppositeIndex].Prefetch();
+
 			// If left mouse is pressed and flipping is allowed
 			// 左クリックされ、フリップ可能な場合
 			if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && canFlip)
 			{
-				// Compute mirrored index (temporary fix for AABB issue)
-				// AABBの不具合による暫定的なミラーインデックス計算
-				int oppositeIndex = totalCards - 1 - i;
-
 				// Skip if card already destroyed
 				// すでに削除済みのカードはスキップする
 				if (gameBoard.getCards()[oppositeIndex].isDestroyed) continue;
@@ -105,6 +110,11 @@ void GameLogic::Update(Shader shaderProgram, float deltaTime, GLFWwindow* window
 			// 両方のカードを削除済みにする
 			gameBoard.getCards()[flippedcardone].isDestroyed = true;
 			gameBoard.getCards()[flippedcardtwo].isDestroyed = true;
+
+			// Their faces will not be seen again until the board is reshuffled
+			// ボードが再シャッフルされるまで、その表面が再び見られることはない
+			gameBoard.getCards()[flippedcardone].ReleaseFace();
+			gameBoard.getCards()[flippedcardtwo].ReleaseFace();
 		}
 		else
 		{
@@ -134,8 +144,10 @@ void GameLogic::Update(Shader shaderProgram, float deltaTime, GLFWwindow* window
 	}
 
 
-	// Update and draw remaining cards
-	// 残っているカードを更新・描画する
+	// Update remaining cards and gather the bounding sphere of each one that has something to draw
+	// 残っているカードを更新し、描画するものがある各カードのバウンディング球を集める
+	candidates.clear();
+	culler.Clear();
 	for (auto& card : gameBoard.getCards())
 	{
 		// Skip destroyed cards
@@ -143,6 +155,30 @@ void GameLogic::Update(Shader shaderProgram, float deltaTime, GLFWwindow* window
 		if (card.isDestroyed) continue;
 
 		card.Update(deltaTime);
-		card.Draw(shaderProgram, camera);
+
+		Model* model = card.PrepareDraw();
+		if (!model)
+			continue;
+
+		// Move the model's sphere into the world through the same chain the meshes are drawn with
+		// (mirror * transform * node); the radius grows by the transform's largest scale
+		// メッシュの描画と同じ行列の連鎖（反転 × 変換 × ノード）でモデルの球をワールドに移す
+		// （半径は変換の最大の拡大率で広げる）
+		const glm::mat4& transform = card.GetTransform().GetModel();
+		glm::vec3 center = glm::vec3(Mesh::WorldMatrix(transform) * glm::vec4(model->GetBoundsCenter(), 1.0f));
+		float scale = std::max(glm::length(glm::vec3(transform[0])), std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+		culler.Add(center, model->GetBoundsRadius() * scale);
+		candidates.push_back({ model, transform });
 	}
+
+	// Test every card against the frustum at once and queue only those on screen
+	// すべてのカードを一度に視錐台に対して判定し、画面上にあるものだけをキューに入れる
+	culler.Cull(camera.frustum);
+	for (size_t i = 0; i < candidates.size(); i++)
+		if (culler.IsVisible(i))
+			renderQueue.Submit(shaderProgram, *candidates[i].model, candidates[i].transform, camera);
+
+	// Draw the queued cards, sorted so draws that share state become one instanced draw
+	// キュー内のカードを描画する（状態を共有する描画が1回のインスタンス描画になるようソートする）
+	renderQueue.Flush();
 }
\ No newline at end of file
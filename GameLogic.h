@@ -4,6 +4,8 @@
 #include "Board.h"
 #include "MousePicker.h"
 #include "Camera.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
 #include <vector>
 
 // GameLogic class responsible for handling gameplay rules and interactions
@@ -18,7 +20,15 @@ public:
 
 	// Main update loop handling input, matching logic, and rendering
 	// 入力処理・マッチ判定・描画を行うメイン更新処理
-	void Update(Shader shaderProgram, float deltaTime, GLFWwindow* window);
+	void Update(Shader& shaderProgram, float deltaTime, GLFWwindow* window);
+
+	// Returns the queue the board is drawn through (e.g. for its draw call counts)
+	// ボードの描画に使うキューを返す（例：描画呼び出し数の取得用）
+	inline const RenderQueue& GetRenderQueue() const { return renderQueue; }
+
+	// Returns the culler the cards are tested against the camera's frustum with (e.g. for its visible and culled counts)
+	// カードをカメラの視錐台に対して判定するカリングを返す（例：表示数とカリング数の取得用）
+	inline const FrustumCuller& GetCuller() const { return culler; }
 
 private:
 
@@ -57,6 +67,23 @@ private:
 	// Reference to the mouse picker (ray casting system)
 	// マウスピッカー（レイキャストシステム）への参照
 	MousePicker& picker;
+
+	// Queue the cards are submitted to and drawn from, sorted into instanced draws
+	// カードを登録し、インスタンス描画にソートして描画するキュー
+	RenderQueue renderQueue;
+
+	// Cards that could be drawn this frame: the model each is drawn with and its transform
+	// このフレームで描画されうるカード（それぞれの描画に使うモデルとその変換）
+	struct DrawCandidate
+	{
+		Model* model;
+		glm::mat4 transform;
+	};
+	std::vector<DrawCandidate> candidates;
+
+	// Culls the candidates' bounding spheres against the camera's frustum in one batch
+	// 候補のバウンディング球をカメラの視錐台に対してまとめてカリングする
+	FrustumCuller culler;
 };
 
 #endif
\ No newline at end of file
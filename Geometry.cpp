@@ -0,0 +1,33 @@
+#include "Geometry.h"
+
+Geometry::Geometry(const VertexLayout& layout, const void* vertices, GLsizei vertexCount, const void* indices, GLsizei indexCount, GLenum indexType)
+	: layout(layout), vertexCount(vertexCount), indexCount(indexCount), indexType(indexType), VBO(vertices, (GLsizeiptr)vertexCount * layout.stride),
+	EBO(indices, (GLsizeiptr)indexCount * (indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)))
+{
+	bufferBytes = (GLsizeiptr)vertexCount * layout.stride + (GLsizeiptr)indexCount * (indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+
+	lods.count = 1;
+	lods.levels[0].indexCount = (uint32_t)indexCount;
+
+	VAO.Bind();
+
+	// Attach the element buffer to this VAO
+	// エレメントバッファをこのVAOに関連付ける
+	EBO.Bind();
+
+	// Link the position, normal and texture coordinate attributes (layouts 0-2) described by the layout
+	// レイアウトに記述された座標・法線・テクスチャ座標の属性（レイアウト0〜2）をリンクする
+	VAO.LinkLayout(VBO, layout);
+
+	VAO.Unbind();
+	VBO.Unbind();
+	EBO.Unbind();
+}
+
+MemoryUsage Geometry::GetMemoryUsage() const
+{
+	MemoryUsage usage;
+	usage.cpuBytes = vertices.capacity() * sizeof(Vertex) + shortIndices.capacity() * sizeof(GLushort) + indices.capacity() * sizeof(GLuint);
+	usage.bufferBytes = bufferBytes;
+	return usage;
+}
\ No newline at end of file
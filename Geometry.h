@@ -0,0 +1,71 @@
+#ifndef GEOMETRY_CLASS_H
+#define GEOMETRY_CLASS_H
+
+#include"VAO.h"
+#include"EBO.h"
+#include"Profiling.h"
+#include"MeshOptimizer.h"
+
+// Geometry class holding the GPU buffers of one mesh so they can be shared
+// 1つのメッシュのGPUバッファを保持し、共有できるようにするGeometryクラス
+class Geometry
+{
+public:
+
+	// CPU copy of the vertices, filled only when a model is loaded with RETAIN_GEOMETRY
+	// 頂点のCPU側コピー（モデルがRETAIN_GEOMETRYで読み込まれた場合のみ埋まる）
+	std::vector <Vertex> vertices;
+
+	// CPU copy of the indices of every level, filled like vertices (shortIndices for 16-bit geometry, indices for 32-bit)
+	// 全レベルのインデックスのCPU側コピー（verticesと同様に埋まる。16ビットのジオメトリはshortIndices、32ビットはindices）
+	std::vector <GLushort> shortIndices;
+	std::vector <GLuint> indices;
+
+	// Layout of the vertices in the vertex buffer (also used to link it into other VAOs, e.g. for instancing)
+	// 頂点バッファ内の頂点のレイアウト（他のVAOへのリンクにも使う。例：インスタンス描画）
+	VertexLayout layout;
+
+	// Number of vertices in the vertex buffer
+	// 頂点バッファ内の頂点数
+	GLsizei vertexCount;
+
+	// Number and GL type of the indices in the element buffer
+	// エレメントバッファ内のインデックス数とGLの型
+	GLsizei indexCount;
+	GLenum indexType;
+
+	// Levels of detail inside the element buffer (a single full level unless the uploader sets more)
+	// エレメントバッファ内の詳細度レベル（アップロード側が設定しない限り、完全なレベル1つ）
+	MeshLodChain lods;
+
+	// Bytes uploaded to the vertex and element buffers
+	// 頂点バッファとエレメントバッファに転送したバイト数
+	GLsizeiptr bufferBytes;
+
+	// Vertex Array Object
+	// 頂点配列オブジェクト（VAO）
+	VAO VAO;
+
+	// Vertex Buffer Object
+	// 頂点バッファオブジェクト（VBO）
+	VBO VBO;
+
+	// Element Buffer Object
+	// エレメントバッファオブジェクト（EBO）
+	EBO EBO;
+
+	// Constructor that uploads vertices of the given layout and index data straight from memory, keeping no CPU copy
+	// CPU側のコピーを持たずに、指定レイアウトの頂点データとインデックスデータをメモリから直接転送するコンストラクタ
+	Geometry(const VertexLayout& layout, const void* vertices, GLsizei vertexCount, const void* indices, GLsizei indexCount, GLenum indexType);
+
+	// Returns the memory held by the CPU copies and the GPU buffers
+	// CPU側コピーとGPUバッファが保持するメモリ量を返す
+	MemoryUsage GetMemoryUsage() const;
+
+	// Geometry owns GL objects (freed with it by their handles), so it is shared through pointers instead of copied
+	// GeometryはGLオブジェクトを所有する（ハンドルによって共に解放される）ため、コピーせずポインタで共有する
+	Geometry(const Geometry&) = delete;
+	Geometry& operator=(const Geometry&) = delete;
+};
+
+#endif
\ No newline at end of file
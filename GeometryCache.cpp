@@ -0,0 +1,64 @@
+#include "GeometryCache.h"
+
+// Looks up live geometry with the same content hash
+// 同じコンテンツハッシュを持つ生存中のジオメトリを検索する
+std::shared_ptr<Geometry> GeometryCache::Find(uint64_t hash, const VertexLayout& layout, GLsizei vertexCount, GLsizei indexCount, GLenum indexType)
+{
+	auto found = geometries.find(hash);
+	if (found == geometries.end())
+		return nullptr;
+
+	std::shared_ptr<Geometry> geometry = found->second.lock();
+	if (!geometry)
+		return nullptr;
+
+	// Equal hashes of different data must not hand out the wrong mesh
+	// 異なるデータのハッシュが等しくても、間違ったメッシュを渡してはならない
+	if (!sameLayout(geometry->layout, layout) || geometry->vertexCount != vertexCount
+		|| geometry->indexCount != indexCount || geometry->indexType != indexType)
+		return nullptr;
+
+	shared++;
+	return geometry;
+}
+
+bool GeometryCache::sameLayout(const VertexLayout& a, const VertexLayout& b)
+{
+	if (a.stride != b.stride || a.attributeCount != b.attributeCount)
+		return false;
+
+	for (unsigned int i = 0; i < a.attributeCount; i++)
+	{
+		const VertexAttribute& x = a.attributes[i];
+		const VertexAttribute& y = b.attributes[i];
+		if (x.location != y.location || x.components != y.components || x.type != y.type
+			|| x.normalized != y.normalized || x.offset != y.offset)
+			return false;
+	}
+	return true;
+}
+
+// Uploads geometry from memory (e.g. a mapped card pack) that was not found in the cache
+// キャッシュに無かったジオメトリをメモリ（例：マッピングされたカードパック）から転送する
+std::shared_ptr<Geometry> GeometryCache::Add(uint64_t hash, const VertexLayout& layout, const void* vertices, GLsizei vertexCount, const void* indices, GLsizei indexCount, GLenum indexType)
+{
+	std::shared_ptr<Geometry> geometry = std::make_shared<Geometry>(layout, vertices, vertexCount, indices, indexCount, indexType);
+	geometries[hash] = geometry;
+	uploads++;
+
+	return geometry;
+}
+
+// Sums the geometries that are still alive
+// まだ生存しているジオメトリを合計する
+MemoryUsage GeometryCache::GetMemoryUsage() const
+{
+	MemoryUsage usage;
+	for (auto& entry : geometries)
+	{
+		std::shared_ptr<Geometry> geometry = entry.second.lock();
+		if (geometry)
+			usage += geometry->GetMemoryUsage();
+	}
+	return usage;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef GEOMETRY_CACHE_CLASS_H
+#define GEOMETRY_CACHE_CLASS_H
+
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include "Geometry.h"
+
+// GeometryCache class that shares one GPU mesh between models with identical geometry
+// 同一ジオメトリを持つモデル間で1つのGPUメッシュを共有するGeometryCacheクラス
+class GeometryCache
+{
+public:
+
+	// Returns the geometry stored under the content hash, or nullptr if none is alive
+	// The hash is only a key: geometry whose layout, vertex count or indices differ from the ones the caller
+	// is about to upload is a collision and is not shared.
+	// コンテンツハッシュに対応するジオメトリを返す（生存していなければnullptr）
+	// ハッシュはキーに過ぎないため、レイアウト・頂点数・インデックスが呼び出し側の転送しようとしているものと
+	// 異なるジオメトリは衝突とみなし、共有しない
+	std::shared_ptr<Geometry> Find(uint64_t hash, const VertexLayout& layout, GLsizei vertexCount, GLsizei indexCount, GLenum indexType);
+
+	// Uploads new geometry of any vertex layout straight from memory and stores it under the content hash
+	// 任意の頂点レイアウトの新しいジオメトリをメモリから直接転送し、コンテンツハッシュで保存する
+	std::shared_ptr<Geometry> Add(uint64_t hash, const VertexLayout& layout, const void* vertices, GLsizei vertexCount, const void* indices, GLsizei indexCount, GLenum indexType);
+
+	// Returns the memory held by every live geometry
+	// 生存中のすべてのジオメトリが保持するメモリ量を返す
+	MemoryUsage GetMemoryUsage() const;
+
+	// Returns the number of geometries uploaded to the GPU
+	// GPUに転送されたジオメトリの数を返す
+	inline unsigned int GetUploadCount() const { return uploads; }
+
+	// Returns the number of requests served by sharing existing geometry
+	// 既存ジオメトリの共有で処理された要求の数を返す
+	inline unsigned int GetSharedCount() const { return shared; }
+
+	// Hashes a block of bytes with 64-bit FNV-1a, continuing from a previous hash
+	// Defined inline so code that never touches OpenGL (ModelData, cardcook) can use it
+	// 64ビットFNV-1aでバイト列をハッシュする（前回のハッシュから続けて計算する）
+	// OpenGLに触れないコード（ModelData、cardcook）でも使えるようインラインで定義する
+	static inline uint64_t HashBytes(const void* bytes, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const unsigned char* data = static_cast<const unsigned char*>(bytes);
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+private:
+
+	// Live geometries keyed by content hash
+	// コンテンツハッシュをキーとした生存中のジオメトリ
+	std::unordered_map<uint64_t, std::weak_ptr<Geometry>> geometries;
+
+	// Number of geometries uploaded to the GPU
+	// GPUに転送されたジオメトリの数
+	unsigned int uploads = 0;
+
+	// Number of requests served by sharing existing geometry
+	// 既存ジオメトリの共有で処理された要求の数
+	unsigned int shared = 0;
+
+	// Returns true if two vertex layouts describe the same attributes (compared field by field, ignoring padding)
+	// 2つの頂点レイアウトが同じ属性を表していればtrueを返す（パディングを無視してフィールドごとに比較する）
+	static bool sameLayout(const VertexLayout& a, const VertexLayout& b);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "KTX2.h"
+
+#include <cstring>
+#include <stdexcept>
+
+// File identifier every KTX 2.0 file starts with
+// すべてのKTX 2.0ファイルの先頭にあるファイル識別子
+static const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// Header that follows the identifier, then the index of the other sections
+// (packed to 4 bytes, since the 64-bit fields are not 8-byte aligned in the file)
+// 識別子に続くヘッダと、その後の各セクションの索引
+// （ファイル内で64ビットのフィールドが8バイト境界に無いため、4バイト単位で詰める）
+#pragma pack(push, 4)
+struct KTX2Header
+{
+	uint32_t vkFormat;
+	uint32_t typeSize;
+	uint32_t pixelWidth;
+	uint32_t pixelHeight;
+	uint32_t pixelDepth;
+	uint32_t layerCount;
+	uint32_t faceCount;
+	uint32_t levelCount;
+	uint32_t supercompressionScheme;
+
+	uint32_t dfdByteOffset;
+	uint32_t dfdByteLength;
+	uint32_t kvdByteOffset;
+	uint32_t kvdByteLength;
+	uint64_t sgdByteOffset;
+	uint64_t sgdByteLength;
+};
+#pragma pack(pop)
+
+// Entry of the level index (one per mip level, largest first)
+// レベル索引のエントリ（ミップレベルごとに1つ、最大レベルから順）
+struct KTX2Level
+{
+	uint64_t byteOffset;
+	uint64_t byteLength;
+	uint64_t uncompressedByteLength;
+};
+
+static_assert(sizeof(KTX2Header) == 68, "KTX2Header layout changed");
+static_assert(sizeof(KTX2Level) == 24, "KTX2Level layout changed");
+
+bool ktx2_is_compressed(uint32_t vkFormat)
+{
+	return vkFormat == KTX2_FORMAT_BC1_RGB_UNORM || vkFormat == KTX2_FORMAT_BC1_RGB_SRGB ||
+		vkFormat == KTX2_FORMAT_BC3_UNORM || vkFormat == KTX2_FORMAT_BC3_SRGB;
+}
+
+uint32_t ktx2_block_size(uint32_t vkFormat)
+{
+	switch (vkFormat)
+	{
+	case KTX2_FORMAT_R8_UNORM:
+		return 1;
+	case KTX2_FORMAT_R8G8B8_UNORM:
+	case KTX2_FORMAT_R8G8B8_SRGB:
+		return 3;
+	case KTX2_FORMAT_R8G8B8A8_UNORM:
+	case KTX2_FORMAT_R8G8B8A8_SRGB:
+		return 4;
+	case KTX2_FORMAT_BC1_RGB_UNORM:
+	case KTX2_FORMAT_BC1_RGB_SRGB:
+		return 8;
+	case KTX2_FORMAT_BC3_UNORM:
+	case KTX2_FORMAT_BC3_SRGB:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+// Returns the size in bytes of one mip level
+// 1つのミップレベルのバイト数を返す
+static uint64_t level_size(uint32_t vkFormat, uint32_t width, uint32_t height)
+{
+	if (ktx2_is_compressed(vkFormat))
+		return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * ktx2_block_size(vkFormat);
+
+	return (uint64_t)width * height * ktx2_block_size(vkFormat);
+}
+
+KTX2Image read_ktx2(const unsigned char* data, size_t size)
+{
+	if (size < sizeof(KTX2_IDENTIFIER) + sizeof(KTX2Header) || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+		throw std::invalid_argument("Texture is not a KTX2 file");
+
+	KTX2Header header;
+	std::memcpy(&header, data + sizeof(KTX2_IDENTIFIER), sizeof(header));
+
+	// Only plain 2D textures are cooked: no arrays, cube maps, depth or supercompression
+	// 調理されるのは単純な2Dテクスチャのみ（配列・キューブマップ・奥行き・超圧縮は無い）
+	if (ktx2_block_size(header.vkFormat) == 0)
+		throw std::invalid_argument("KTX2 texture format is not supported");
+	if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 || header.layerCount > 1 ||
+		header.faceCount != 1 || header.supercompressionScheme != 0 || header.levelCount == 0)
+		throw std::invalid_argument("KTX2 texture layout is not supported");
+
+	size_t levelIndex = sizeof(KTX2_IDENTIFIER) + sizeof(KTX2Header);
+	if ((size - levelIndex) / sizeof(KTX2Level) < header.levelCount)
+		throw std::invalid_argument("KTX2 level index reaches past the end of the file");
+
+	KTX2Image image;
+	image.vkFormat = header.vkFormat;
+	image.width = header.pixelWidth;
+	image.height = header.pixelHeight;
+
+	// Check every level against the file size and the size its dimensions need
+	// 各レベルをファイルサイズと、その寸法に必要なサイズと照合する
+	uint32_t width = header.pixelWidth;
+	uint32_t height = header.pixelHeight;
+	for (uint32_t i = 0; i < header.levelCount; i++)
+	{
+		KTX2Level level;
+		std::memcpy(&level, data + levelIndex + i * sizeof(KTX2Level), sizeof(level));
+
+		if (level.byteOffset > size || level.byteLength > size - level.byteOffset)
+			throw std::invalid_argument("KTX2 level reaches past the end of the file");
+		if (level.byteLength != level_size(header.vkFormat, width, height))
+			throw std::invalid_argument("KTX2 level has the wrong size");
+
+		ByteRange range;
+		range.data = data + level.byteOffset;
+		range.size = (size_t)level.byteLength;
+		image.levels.push_back(range);
+
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return image;
+}
+
+// Appends a 32-bit little-endian value
+// 32ビットのリトルエンディアン値を追加する
+static void put_u32(std::vector<unsigned char>& out, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		out.push_back((unsigned char)(value >> (i * 8)));
+}
+
+// Builds the basic data format descriptor the KTX2 format requires
+// KTX2フォーマットが必要とする基本データフォーマット記述子を作成する
+static std::vector<unsigned char> build_dfd(uint32_t vkFormat)
+{
+	// Color model, block size, and one sample per channel: { bit offset, bit length, channel id }
+	// カラーモデル・ブロックサイズ・チャンネルごとに1つのサンプル：{ ビットオフセット, ビット長, チャンネルID }
+	uint32_t colorModel = 1;
+	uint32_t blockDimension = 0;
+	uint32_t samples[4][3];
+	uint32_t sampleCount = 0;
+	bool srgb = vkFormat == KTX2_FORMAT_R8G8B8_SRGB || vkFormat == KTX2_FORMAT_R8G8B8A8_SRGB ||
+		vkFormat == KTX2_FORMAT_BC1_RGB_SRGB || vkFormat == KTX2_FORMAT_BC3_SRGB;
+
+	if (ktx2_is_compressed(vkFormat))
+	{
+		// 4x4 blocks; BC3 holds an alpha block followed by a color block
+		// 4x4ブロック（BC3はアルファブロックの後にカラーブロックを持つ）
+		blockDimension = 3 | (3 << 8);
+		if (vkFormat == KTX2_FORMAT_BC1_RGB_UNORM || vkFormat == KTX2_FORMAT_BC1_RGB_SRGB)
+		{
+			colorModel = 128;
+			samples[sampleCount][0] = 0; samples[sampleCount][1] = 64; samples[sampleCount++][2] = 0;
+		}
+		else
+		{
+			colorModel = 130;
+			samples[sampleCount][0] = 0; samples[sampleCount][1] = 64; samples[sampleCount++][2] = 15;
+			samples[sampleCount][0] = 64; samples[sampleCount][1] = 64; samples[sampleCount++][2] = 0;
+		}
+	}
+	else
+	{
+		// One 8-bit sample per channel: red, green, blue, then alpha (channel 15)
+		// チャンネルごとに8ビットのサンプルを1つ：赤・緑・青、その後にアルファ（チャンネル15）
+		uint32_t channels = ktx2_block_size(vkFormat);
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			samples[sampleCount][0] = c * 8;
+			samples[sampleCount][1] = 8;
+			samples[sampleCount++][2] = c == 3 ? 15 : c;
+		}
+	}
+
+	uint32_t blockSize = 24 + 16 * sampleCount;
+	std::vector<unsigned char> dfd;
+	put_u32(dfd, 4 + blockSize);
+	put_u32(dfd, 0);
+	put_u32(dfd, 2 | (blockSize << 16));
+	put_u32(dfd, colorModel | (1 << 8) | ((srgb ? 2 : 1) << 16));
+	put_u32(dfd, blockDimension);
+	put_u32(dfd, ktx2_block_size(vkFormat));
+	put_u32(dfd, 0);
+
+	for (uint32_t i = 0; i < sampleCount; i++)
+	{
+		// sRGB applies to the color channels only, so alpha is marked linear
+		// sRGBはカラーチャンネルにのみ適用されるため、アルファは線形として示す
+		uint32_t qualifiers = srgb && samples[i][2] == 15 ? 1 : 0;
+		put_u32(dfd, samples[i][0] | ((samples[i][1] - 1) << 16) | (samples[i][2] << 24) | (qualifiers << 28));
+		put_u32(dfd, 0);
+		put_u32(dfd, 0);
+		put_u32(dfd, samples[i][1] == 8 ? 255 : 0xFFFFFFFF);
+	}
+
+	return dfd;
+}
+
+std::vector<unsigned char> write_ktx2(uint32_t vkFormat, uint32_t width, uint32_t height, const std::vector<std::vector<unsigned char>>& levels)
+{
+	if (ktx2_block_size(vkFormat) == 0)
+		throw std::invalid_argument("KTX2 texture format is not supported");
+
+	std::vector<unsigned char> dfd = build_dfd(vkFormat);
+
+	KTX2Header header = {};
+	header.vkFormat = vkFormat;
+	header.typeSize = 1;
+	header.pixelWidth = width;
+	header.pixelHeight = height;
+	header.faceCount = 1;
+	header.levelCount = (uint32_t)levels.size();
+	header.dfdByteOffset = (uint32_t)(sizeof(KTX2_IDENTIFIER) + sizeof(KTX2Header) + levels.size() * sizeof(KTX2Level));
+	header.dfdByteLength = (uint32_t)dfd.size();
+
+	// Level data is stored smallest level first, each aligned to a multiple of the block size and of 4
+	// レベルデータは最小レベルから順に格納する（各レベルはブロックサイズと4の公倍数に揃える）
+	uint64_t alignment = ktx2_block_size(vkFormat);
+	while (alignment % 4 != 0)
+		alignment += ktx2_block_size(vkFormat);
+
+	std::vector<KTX2Level> index(levels.size());
+	uint64_t offset = header.dfdByteOffset + header.dfdByteLength;
+	for (size_t i = levels.size(); i-- > 0;)
+	{
+		offset = (offset + alignment - 1) / alignment * alignment;
+		index[i].byteOffset = offset;
+		index[i].byteLength = levels[i].size();
+		index[i].uncompressedByteLength = levels[i].size();
+		offset += levels[i].size();
+	}
+
+	std::vector<unsigned char> file(offset, 0);
+	std::memcpy(file.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+	std::memcpy(file.data() + sizeof(KTX2_IDENTIFIER), &header, sizeof(header));
+	std::memcpy(file.data() + sizeof(KTX2_IDENTIFIER) + sizeof(header), index.data(), index.size() * sizeof(KTX2Level));
+	std::memcpy(file.data() + header.dfdByteOffset, dfd.data(), dfd.size());
+	for (size_t i = 0; i < levels.size(); i++)
+		std::memcpy(file.data() + index[i].byteOffset, levels[i].data(), levels[i].size());
+
+	return file;
+}
\ No newline at end of file
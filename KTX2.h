@@ -0,0 +1,54 @@
+#ifndef KTX2_H
+#define KTX2_H
+
+#include <vector>
+#include <cstdint>
+#include "MappedFile.h"
+
+// Minimal reader and writer for KTX 2.0 textures (single 2D image, no supercompression)
+// The cardcook tool stores every cooked texture as one of these inside the card pack.
+// KTX 2.0テクスチャの最小限の読み書き（単一の2D画像、超圧縮なし）
+// cardcookツールは調理したテクスチャをすべてこの形式でカードパック内に格納する
+
+// Vulkan format numbers used in the vkFormat field
+// vkFormatフィールドで使うVulkanのフォーマット番号
+static const uint32_t KTX2_FORMAT_R8_UNORM = 9;
+static const uint32_t KTX2_FORMAT_R8G8B8_UNORM = 23;
+static const uint32_t KTX2_FORMAT_R8G8B8_SRGB = 29;
+static const uint32_t KTX2_FORMAT_R8G8B8A8_UNORM = 37;
+static const uint32_t KTX2_FORMAT_R8G8B8A8_SRGB = 43;
+static const uint32_t KTX2_FORMAT_BC1_RGB_UNORM = 131;
+static const uint32_t KTX2_FORMAT_BC1_RGB_SRGB = 132;
+static const uint32_t KTX2_FORMAT_BC3_UNORM = 137;
+static const uint32_t KTX2_FORMAT_BC3_SRGB = 138;
+
+// A KTX2 texture read from memory; the levels point into the source bytes
+// メモリから読み取ったKTX2テクスチャ（各レベルは元のバイト列を指す）
+struct KTX2Image
+{
+	uint32_t vkFormat = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+
+	// Mip levels, largest first
+	// ミップレベル（最大レベルから順）
+	std::vector<ByteRange> levels;
+};
+
+// Returns true for the block-compressed formats above
+// 上記のうちブロック圧縮フォーマットであればtrueを返す
+bool ktx2_is_compressed(uint32_t vkFormat);
+
+// Returns the bytes per texel (uncompressed) or per 4x4 block (compressed), or 0 if unsupported
+// 1テクセル（非圧縮）または4x4ブロック（圧縮）あたりのバイト数を返す（未対応の場合は0）
+uint32_t ktx2_block_size(uint32_t vkFormat);
+
+// Parses a KTX2 file held in memory; throws std::invalid_argument if it is not one this reader supports
+// メモリ上のKTX2ファイルを解析する（このリーダーが対応していない場合はstd::invalid_argumentを投げる）
+KTX2Image read_ktx2(const unsigned char* data, size_t size);
+
+// Builds a KTX2 file from mip levels given largest first
+// 最大レベルから順に与えられたミップレベルからKTX2ファイルを作成する
+std::vector<unsigned char> write_ktx2(uint32_t vkFormat, uint32_t width, uint32_t height, const std::vector<std::vector<unsigned char>>& levels);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* filename)
+{
+	Open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+
+		// Take over the other mapping and leave it empty
+		// 相手のマッピングを引き継ぎ、相手を空にする
+		std::swap(bytes, other.bytes);
+		std::swap(size, other.size);
+#ifdef _WIN32
+		std::swap(fileHandle, other.fileHandle);
+		std::swap(mappingHandle, other.mappingHandle);
+#endif
+	}
+	return *this;
+}
+
+void MappedFile::Open(const char* filename)
+{
+	Close();
+
+#ifdef _WIN32
+	// Open the file and create a read-only mapping of all of it
+	// ファイルを開き、全体の読み取り専用マッピングを作成する
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw(ENOENT);
+	fileHandle = file;
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(file, &fileSize);
+	size = (size_t)fileSize.QuadPart;
+
+	// Empty files cannot be mapped, so leave them as a zero-length view
+	// 空のファイルはマッピングできないため、長さ0のビューのままにする
+	if (size == 0)
+		return;
+
+	mappingHandle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappingHandle == NULL)
+	{
+		Close();
+		throw(EIO);
+	}
+
+	bytes = (const unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (bytes == nullptr)
+	{
+		Close();
+		throw(EIO);
+	}
+#else
+	// Open the file and map all of it read-only
+	// ファイルを開き、全体を読み取り専用でマッピングする
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		throw(errno);
+
+	struct stat info;
+	fstat(fd, &info);
+	size = (size_t)info.st_size;
+
+	// Empty files cannot be mapped, so leave them as a zero-length view
+	// 空のファイルはマッピングできないため、長さ0のビューのままにする
+	if (size == 0)
+	{
+		close(fd);
+		return;
+	}
+
+	void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps the file alive, so the descriptor can be closed now
+	// マッピングがファイルを保持するため、ディスクリプタはここで閉じてよい
+	close(fd);
+
+	if (view == MAP_FAILED)
+	{
+		size = 0;
+		throw(errno);
+	}
+	bytes = (const unsigned char*)view;
+#endif
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (bytes)
+		UnmapViewOfFile(bytes);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle)
+		CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	if (bytes)
+		munmap((void*)bytes, size);
+#endif
+	bytes = nullptr;
+	size = 0;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef MAPPED_FILE_CLASS_H
+#define MAPPED_FILE_CLASS_H
+
+#include <cstddef>
+
+// Read-only range of bytes inside a mapping (or any other memory)
+// マッピング（または他のメモリ）内の読み取り専用バイト範囲
+struct ByteRange
+{
+	const unsigned char* data = nullptr;
+	size_t size = 0;
+};
+
+// MappedFile class that maps a whole file read-only into memory
+// ファイル全体を読み取り専用でメモリにマッピングするMappedFileクラス
+class MappedFile
+{
+public:
+
+	// Constructor that creates an empty (unmapped) file
+	// 空の（マッピングされていない）ファイルを作成するコンストラクタ
+	MappedFile() = default;
+
+	// Constructor that maps the given file
+	// 指定されたファイルをマッピングするコンストラクタ
+	MappedFile(const char* filename);
+
+	// Destructor that unmaps the file
+	// ファイルのマッピングを解除するデストラクタ
+	~MappedFile();
+
+	// A mapping has a single owner, so it can be moved but not copied
+	// マッピングの所有者は1つのため、ムーブはできるがコピーはできない
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	// Maps the given file, replacing any previous mapping
+	// 指定されたファイルをマッピングする（以前のマッピングは置き換えられる）
+	void Open(const char* filename);
+
+	// Unmaps the file and releases its handles
+	// ファイルのマッピングを解除し、ハンドルを解放する
+	void Close();
+
+	// Returns a pointer to the first byte of the file
+	// ファイルの先頭バイトへのポインタを返す
+	inline const unsigned char* Data() const { return bytes; }
+
+	// Returns the size of the file in bytes
+	// ファイルのバイトサイズを返す
+	inline size_t Size() const { return size; }
+
+	// Returns the byte at the given offset
+	// 指定されたオフセットのバイトを返す
+	inline const unsigned char& operator[](size_t i) const { return bytes[i]; }
+
+private:
+
+	// Start of the mapped view
+	// マッピングされたビューの先頭
+	const unsigned char* bytes = nullptr;
+
+	// Size of the mapped view in bytes
+	// マッピングされたビューのバイトサイズ
+	size_t size = 0;
+
+#ifdef _WIN32
+	// Win32 file and file-mapping handles
+	// Win32のファイルハンドルとファイルマッピングハンドル
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
\ No newline at end of file
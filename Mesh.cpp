@@ -1,117 +1,100 @@
 #include "Mesh.h"
 
-Mesh::Mesh(std::vector <Vertex>& vertices, std::vector <GLuint> indices, std::vector <Texture>& textures)
-{
-	Mesh::vertices = vertices;
-	Mesh::indices = indices;
-	Mesh::textures = textures;
-
-	VAO.Bind();
-
-	// Generates vertex buffer object and links it to vertices
-	// 頂点データを格納するVBO（頂点バッファオブジェクト）を生成し、頂点情報を送る
-	VBO VBO(vertices);
-
-	// Generates element buffer object and links it to indices
-	// インデックス情報を格納するEBO（エレメントバッファオブジェクト）を生成する
-	EBO EBO(indices);
+#include <algorithm>
+#include <cstring>
 
-	// Link attributes for coordinates (layout 0)
-	// 座標属性をレイアウト0にリンクする
-	VAO.LinkAttrib(VBO, 0, 3, GL_FLOAT, sizeof(Vertex), (void*)0);
+// Sampler uniform names by texture type and index
+// テクスチャの種類とインデックスごとのサンプラーuniform名
+static const char* const DIFFUSE_SAMPLERS[MAX_MESH_SAMPLERS] = { "diffuse0", "diffuse1", "diffuse2", "diffuse3" };
+static const char* const SPECULAR_SAMPLERS[MAX_MESH_SAMPLERS] = { "specular0", "specular1", "specular2", "specular3" };
 
-	// Link attributes for normals (layout 1)
-	// 法線ベクトルをレイアウト1にリンクする
-	VAO.LinkAttrib(VBO, 1, 3, GL_FLOAT, sizeof(Vertex), (void*)(3 * sizeof(GLfloat)));
-
-	// Link attributes for colors (layout 2)
-	// 頂点カラーをレイアウト2にリンクする
-	VAO.LinkAttrib(VBO, 2, 3, GL_FLOAT, sizeof(Vertex), (void*)(6 * sizeof(GLfloat)));
+Mesh::Mesh(std::shared_ptr<Geometry> geometry)
+{
+	Mesh::geometry = geometry;
+}
 
-	// Link attributes for textures (layout 3)
-	// テクスチャ座標をレイアウト3にリンクする
-	VAO.LinkAttrib(VBO, 3, 2, GL_FLOAT, sizeof(Vertex), (void*)(9 * sizeof(GLfloat)));
+glm::mat4 Mesh::WorldMatrix(const glm::mat4& matrix)
+{
+	// Mirroring through the origin negates x, y and z; the product is the same as with a negated rotation
+	// 原点に対する反転はx・y・zを反転する（積は反転した回転の場合と同じ）
+	glm::mat4 mirror = glm::scale(glm::mat4(1.0f), glm::vec3(-1.0f));
+	return mirror * matrix;
+}
 
-	VAO.Unbind();
-	VBO.Unbind();
-	EBO.Unbind();
+glm::mat3 Mesh::NormalMatrix(const glm::mat4& world)
+{
+	return glm::transpose(glm::inverse(glm::mat3(world)));
 }
 
-void Mesh::Draw
-(
-	Shader& shader,
-	Camera& camera,
-	glm::mat4 matrix,
-	glm::vec3 translation,
-	glm::quat rotation,
-	glm::vec3 scale
-)
+unsigned int Mesh::SelectLod(const glm::mat4& world, const Camera& camera) const
 {
-	shader.Activate();
-	VAO.Bind();
+	const MeshLodChain& lods = geometry->lods;
+	if (lods.count <= 1)
+		return 0;
+
+	glm::vec3 center = glm::vec3(world * glm::vec4(lods.center, 1.0f));
+	float scale = std::max(glm::length(glm::vec3(world[0])), std::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+
+	// Measure from the nearest point of the bounding sphere; inside it, draw the full mesh
+	// バウンディング球の最も近い点から測る（球の内側では完全なメッシュを描画する）
+	float distance = glm::length(center - camera.cameraPosition) - lods.radius * scale;
+	if (distance <= 0.0f)
+		return 0;
+
+	// Pixels one mesh unit covers at that distance
+	// その距離でメッシュの1単位が覆うピクセル数
+	float pixelsPerUnit = scale * camera.projectionMatrix[1][1] * camera.height * 0.5f / distance;
+
+	// A very distant flat mesh is drawn as its impostor, whose error is mostly in its texture, not its shape
+	// 非常に遠い平らなメッシュはインポスターで描画する（誤差は形よりもテクスチャに出る）
+	if (lods.levels[lods.count - 1].impostor && lods.radius * pixelsPerUnit < impostorPixels)
+		return lods.count - 1;
+
+	unsigned int lod = 0;
+	for (unsigned int i = 1; i < lods.count; i++)
+		if (!lods.levels[i].impostor && lods.levels[i].error * pixelsPerUnit <= lodPixelError)
+			lod = i;
+
+	return lod;
+}
 
+void Mesh::BindTextures(Shader& shader, std::vector <Texture>& textures)
+{
 	unsigned int numDiffuse = 0;
 	unsigned int numSpecular = 0;
 
-	// Bind all textures and assign them to shader uniforms
-	// すべてのテクスチャをバインドし、対応するuniformに割り当てる
+	// Bind the textures and assign them to shader uniforms (names come from fixed tables, so nothing is built per frame)
+	// Diffuse sampler N uses unit N and specular sampler N unit MAX_MESH_SAMPLERS + N, so a mesh never touches
+	// the units from MESH_TEXTURE_UNITS on; textures without a sampler are not bound at all.
+	// テクスチャをバインドし、対応するuniformに割り当てる（名前は固定の表から取るため、毎フレーム作らない）
+	// diffuseサンプラーNはユニットN、specularサンプラーNはユニットMAX_MESH_SAMPLERS + Nを使うため、
+	// メッシュがMESH_TEXTURE_UNITS以降のユニットに触れることはない（サンプラーの無いテクスチャはバインドしない）
 	for (unsigned int i = 0; i < textures.size(); i++)
 	{
-		std::string num;
-		std::string type = textures[i].type;
-
-		if (type == "diffuse")
+		const char* uniform = nullptr;
+		GLuint unit = 0;
+		if (std::strcmp(textures[i].type, "diffuse") == 0 && numDiffuse < MAX_MESH_SAMPLERS)
 		{
-			num = std::to_string(numDiffuse++);
+			unit = numDiffuse;
+			uniform = DIFFUSE_SAMPLERS[numDiffuse++];
 		}
-		else if (type == "specular")
+		else if (std::strcmp(textures[i].type, "specular") == 0 && numSpecular < MAX_MESH_SAMPLERS)
 		{
-			num = std::to_string(numSpecular++);
+			unit = MAX_MESH_SAMPLERS + numSpecular;
+			uniform = SPECULAR_SAMPLERS[numSpecular++];
 		}
+		if (!uniform)
+			continue;
 
-		textures[i].texUnit(shader, (type + num).c_str(), i);
+		textures[i].unit = unit;
+		textures[i].texUnit(shader, uniform, unit);
 		textures[i].Bind();
 	}
 
-	// Send camera position to shader
-	// カメラの位置情報をシェーダーへ送る
-	glUniform3f(
-		glGetUniformLocation(shader.ID, "cameraPos"),
-		camera.cameraPosition.x,
-		camera.cameraPosition.y,
-		camera.cameraPosition.z
-	);
-
-	// Send camera matrix (view * projection)
-	// カメラ行列（ビュー×プロジェクション）を送信
-	camera.Matrix(shader, "camMatrix");
-
-	// Initialize transformation matrices
-	// 各変換行列を初期化
-	glm::mat4 trans = glm::mat4(1.0f);
-	glm::mat4 rot = glm::mat4(1.0f);
-	glm::mat4 sca = glm::mat4(1.0f);
-
-	// Apply translation
-	// 平行移動を適用
-	trans = glm::translate(trans, translation);
-
-	// Apply rotation (quaternion → matrix)
-	// クォータニオンを回転行列に変換
-	rot = glm::mat4_cast(rotation);
-
-	// Apply scaling
-	// 拡大縮小を適用
-	sca = glm::scale(sca, scale);
-
-	// Send transformation matrices to shader
-	// 各変換行列をシェーダーへ送信
-	glUniformMatrix4fv(glGetUniformLocation(shader.ID, "translation"), 1, GL_FALSE, glm::value_ptr(trans));
-	glUniformMatrix4fv(glGetUniformLocation(shader.ID, "rotation"), 1, GL_FALSE, glm::value_ptr(rot));
-	glUniformMatrix4fv(glGetUniformLocation(shader.ID, "scale"), 1, GL_FALSE, glm::value_ptr(sca));
-	glUniformMatrix4fv(glGetUniformLocation(shader.ID, "model"), 1, GL_FALSE, glm::value_ptr(matrix));
-
-	// Draw the mesh using indexed drawing
-	// インデックス描画でメッシュを描画する
-	glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+	// Without a specular map the specular term reads the red of the diffuse texture, as it did when every
+	// sampler defaulted to unit 0, instead of whatever was left in specular0 by the previous material
+	// specularマップが無い場合、specular項は前のマテリアルがspecular0に残したものではなく、すべてのサンプラーが
+	// ユニット0を既定としていた頃と同じくdiffuseテクスチャの赤を読む
+	if (numSpecular == 0)
+		shader.SetInt(SPECULAR_SAMPLERS[0], 0);
 }
\ No newline at end of file
@@ -2,59 +2,62 @@
 #define MESH_CLASS_H
 
 #include<string.h>
+#include<memory>
 
-#include"VAO.h"
-#include"EBO.h"
+#include"Geometry.h"
 #include"Camera.h"
 #include"textureClass.h"
 
+// Most diffuse and most specular samplers a mesh binds; its textures only ever use the units below
+// MESH_TEXTURE_UNITS, so textures shared by every mesh (e.g. the card face array) take the units from there on
+// メッシュがバインドするdiffuseとspecularのサンプラーの最大数（メッシュのテクスチャはMESH_TEXTURE_UNITS未満の
+// ユニットしか使わないため、すべてのメッシュで共有するテクスチャ（例：カード表面の配列）はそれ以降のユニットを使う）
+static const unsigned int MAX_MESH_SAMPLERS = 4;
+static const unsigned int MESH_TEXTURE_UNITS = MAX_MESH_SAMPLERS * 2;
+
 class Mesh
 {
 public:
 
-	// Vertex data (positions, normals, colors, texture coordinates)
-	// 頂点データ（座標・法線・カラー・テクスチャ座標）
-	std::vector <Vertex> vertices;
-
-	// Index data for indexed drawing
-	// インデックス描画用のインデックスデータ
-	std::vector <GLuint> indices;
-
-	// List of textures used by this mesh
-	// このメッシュで使用されるテクスチャの一覧
-	std::vector <Texture> textures;
-
-	// Vertex Array Object
-	// 頂点配列オブジェクト（VAO）
-	VAO VAO;
-
-	// Constructor that initializes mesh data and GPU buffers
-	// メッシュデータおよびGPUバッファを初期化するコンストラクタ
-	Mesh(std::vector <Vertex>& vertices, std::vector <GLuint> indices, std::vector <Texture>& textures);
-
-	// Draws the mesh with optional transformation parameters
-	// 変換パラメータを指定してメッシュを描画する
-	void Draw
-	(
-		Shader& shader,
-		Camera& camera,
-
-		// Model matrix (optional)
-		// モデル行列（省略可能）
-		glm::mat4 matrix = glm::mat4(1.0f),
-
-		// Translation vector
-		// 平行移動ベクトル
-		glm::vec3 translation = glm::vec3(0.0f, 0.0f, 0.0f),
-
-		// Rotation (quaternion)
-		// 回転（クォータニオン）
-		glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
-
-		// Scale vector
-		// 拡大縮小ベクトル
-		glm::vec3 scale = glm::vec3(1.0f, 1.0f, 1.0f)
-	);
+	// GPU geometry, shared with every mesh whose vertex and index data match
+	// GPUジオメトリ（頂点・インデックスデータが一致するすべてのメッシュと共有される）
+	std::shared_ptr<Geometry> geometry;
+
+	// Largest error, in pixels, a level of detail may show on screen
+	// 詳細度レベルが画面上に見せてよい最大誤差（ピクセル）
+	static inline float lodPixelError = 1.0f;
+
+	// Screen radius, in pixels, under which a flat mesh is drawn as its quad impostor (0 never uses impostors)
+	// 平らなメッシュを四角形インポスターで描画する画面上の半径（ピクセル。0の場合はインポスターを使わない）
+	static inline float impostorPixels = 8.0f;
+
+	// Constructor that wraps shared geometry
+	// 共有ジオメトリを包むコンストラクタ
+	Mesh(std::shared_ptr<Geometry> geometry);
+
+	// Returns the world matrix a mesh placed by matrix (the object transform times the node matrix) is drawn with
+	// default.vert used to build it per vertex as matrix * translation * -rotation * scale with an identity
+	// translation, rotation and scale (the node's TRS is already in the matrix); negating the rotation mirrors every
+	// position through the origin, which is all that is left here, kept so the board looks the same
+	// matrix（オブジェクトの変換×ノードの行列）で配置されるメッシュの描画に使うワールド行列を返す
+	// 以前はdefault.vertが頂点ごとにmatrix * translation * -rotation * scaleとして作っていたが、translation・
+	// rotation・scaleは単位のままだった（ノードのTRSは行列に含まれる）。rotationの反転はすべての位置を原点に対して
+	// 反転させ、ここに残るのはそれだけだが、ボードの見た目を変えないよう維持する
+	static glm::mat4 WorldMatrix(const glm::mat4& matrix);
+
+	// Returns the matrix normals are transformed with (the inverse transpose of the world matrix's upper 3x3)
+	// 法線の変換に使う行列を返す（ワールド行列の左上3x3の逆転置）
+	static glm::mat3 NormalMatrix(const glm::mat4& world);
+
+	// Binds textures to their units and points the shader's diffuseN / specularN samplers at them
+	// テクスチャをそれぞれのユニットにバインドし、シェーダーのdiffuseN / specularNサンプラーをそこに向ける
+	static void BindTextures(Shader& shader, std::vector <Texture>& textures);
+
+	// Picks the coarsest level of detail whose error stays within lodPixelError at the mesh's distance from the camera
+	// world is the matrix the mesh is drawn with (see WorldMatrix)
+	// カメラからのメッシュの距離で、誤差がlodPixelError以内に収まる最も粗い詳細度レベルを選ぶ
+	// worldはメッシュの描画に使う行列（WorldMatrixを参照）
+	unsigned int SelectLod(const glm::mat4& world, const Camera& camera) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,681 @@
+#include "MeshOptimizer.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <set>
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include "GeometryCache.h"
+
+// Cache size the triangle order is tuned for (Forsyth's LRU model; also good for smaller FIFO caches)
+// 三角形の順序を合わせるキャッシュサイズ（ForsythのLRUモデル。より小さいFIFOキャッシュにも有効）
+static const unsigned int FORSYTH_CACHE_SIZE = 32;
+
+// How much the overdraw pass may worsen a cluster's ACMR to get smaller, better sortable clusters
+// オーバードローの処理で、より小さく並べ替えやすいクラスタを得るためにACMRを悪化させてよい割合
+static const float OVERDRAW_THRESHOLD = 1.05f;
+
+// Grid resolutions tried for the clustered levels of detail, in cells along the mesh's longest side
+// クラスタリングによる詳細度レベルで試すグリッドの解像度（メッシュの最長辺に沿ったセル数）
+static const unsigned int LOD_GRID_RESOLUTIONS[] = { 32, 16, 8, 4 };
+
+// A level is only kept if it has at most this fraction of the triangles of the previous one
+// 1つ前のレベルに対する三角形の割合がこれ以下の場合のみ、レベルを残す
+static const float LOD_REDUCTION = 0.6f;
+
+// A mesh is flat enough for a quad impostor if its thinnest side is at most this fraction of the others
+// 最も薄い辺が他の辺のこの割合以下であれば、メッシュは四角形インポスターにできるほど平ら
+static const float IMPOSTOR_FLATNESS = 0.1f;
+
+// Largest texture coordinate error allowed when fitting the impostor's quads to the faces
+// (the card's faces bend their mapping by about 1/100 near the rounded corners)
+// インポスターの四角形を面に合わせるときに許すテクスチャ座標の最大誤差
+// （カードの面は角の丸みの付近でマッピングが約1/100曲がっている）
+static const float IMPOSTOR_UV_TOLERANCE = 1.0f / 64.0f;
+
+// Runs the vertices of one triangle through a FIFO cache and returns how many missed
+// A vertex is in the cache if fewer than cacheSize vertices were added since it was, so flushing only moves time.
+// 1つの三角形の頂点をFIFOキャッシュに通し、ミスした数を返す
+// 頂点は、それ以降に追加された頂点がcacheSize個未満ならキャッシュ内にある（フラッシュは時刻を進めるだけ）
+static unsigned int fifoTriangle(const uint32_t* triangle, std::vector<unsigned int>& timestamps, unsigned int& time, unsigned int cacheSize)
+{
+	unsigned int misses = 0;
+	for (int k = 0; k < 3; k++)
+	{
+		uint32_t v = triangle[k];
+		if (time - timestamps[v] > cacheSize)
+		{
+			timestamps[v] = time++;
+			misses++;
+		}
+	}
+	return misses;
+}
+
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+	VertexCacheStats stats;
+	if (indices.size() < 3 || vertexCount == 0)
+		return stats;
+
+	std::vector<unsigned int> timestamps(vertexCount, 0);
+	unsigned int time = cacheSize + 1;
+	size_t misses = 0;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		misses += fifoTriangle(&indices[i], timestamps, time, cacheSize);
+
+	stats.acmr = (float)misses / (float)(indices.size() / 3);
+	stats.atvr = (float)misses / (float)vertexCount;
+	return stats;
+}
+
+// Merges bit-identical vertices (exports split vertices along every edge of the UV islands and material groups)
+// ビット単位で同一の頂点を統合する（エクスポートではUVアイランドやマテリアルの境界で頂点が分割される）
+static void mergeVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	struct VertexHash
+	{
+		const Vertex* vertices;
+		size_t operator()(uint32_t i) const { return (size_t)GeometryCache::HashBytes(&vertices[i], sizeof(Vertex)); }
+	};
+	struct VertexEqual
+	{
+		const Vertex* vertices;
+		bool operator()(uint32_t a, uint32_t b) const { return std::memcmp(&vertices[a], &vertices[b], sizeof(Vertex)) == 0; }
+	};
+
+	std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> unique(vertices.size(), VertexHash{ vertices.data() }, VertexEqual{ vertices.data() });
+
+	// Map each vertex to the first one equal to it, numbered in the merged array
+	// 各頂点を、それと等しい最初の頂点（統合後の配列での番号）に対応付ける
+	std::vector<uint32_t> remap(vertices.size());
+	std::vector<Vertex> merged;
+	merged.reserve(vertices.size());
+	for (uint32_t i = 0; i < (uint32_t)vertices.size(); i++)
+	{
+		auto inserted = unique.emplace(i, (uint32_t)merged.size());
+		if (inserted.second)
+			merged.push_back(vertices[i]);
+		remap[i] = inserted.first->second;
+	}
+
+	for (uint32_t& index : indices)
+		index = remap[index];
+	vertices = std::move(merged);
+}
+
+// Score of a vertex in Forsyth's algorithm: vertices just used score high, vertices with few triangles left
+// score higher so the mesh is not left with lonely triangles
+// Forsythのアルゴリズムでの頂点のスコア（直前に使った頂点ほど高く、残りの三角形が少ない頂点ほど
+// 高くすることで、孤立した三角形が残らないようにする）
+static float forsythScore(int cachePosition, unsigned int remaining)
+{
+	if (remaining == 0)
+		return -1.0f;
+
+	float score = 0.0f;
+	if (cachePosition >= 3)
+		score = std::pow(1.0f - (float)(cachePosition - 3) / (float)(FORSYTH_CACHE_SIZE - 3), 1.5f);
+	else if (cachePosition >= 0)
+		score = 0.75f;
+
+	return score + 2.0f / std::sqrt((float)remaining);
+}
+
+// Reorders triangles for the post-transform vertex cache (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation")
+// 変換後頂点キャッシュのために三角形を並べ替える（Tom Forsyth「Linear-Speed Vertex Cache Optimisation」）
+static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	size_t triangleCount = indices.size() / 3;
+
+	// Triangles of each vertex; the first remaining[v] entries of a vertex are the ones not yet emitted
+	// 各頂点の三角形（頂点ごとに先頭のremaining[v]個が未出力の三角形）
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (uint32_t v : indices)
+		remaining[v]++;
+
+	std::vector<size_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; v++)
+		offsets[v + 1] = offsets[v] + remaining[v];
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < indices.size(); i++)
+		adjacency[cursor[indices[i]]++] = (uint32_t)(i / 3);
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+		vertexScore[v] = forsythScore(-1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	long best = -1;
+	float bestScore = -1.0f;
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+		if (triangleScore[t] > bestScore)
+		{
+			best = (long)t;
+			bestScore = triangleScore[t];
+		}
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+	size_t scan = 0;
+
+	while (result.size() < indices.size())
+	{
+		// No cached vertex has triangles left, so continue with the next triangle in the original order
+		// キャッシュ内の頂点に三角形が残っていないため、元の順序で次の三角形から続ける
+		if (best < 0)
+		{
+			while (emitted[scan])
+				scan++;
+			best = (long)scan;
+		}
+
+		const uint32_t* triangle = &indices[best * 3];
+		emitted[best] = true;
+		result.insert(result.end(), triangle, triangle + 3);
+
+		// Remove the triangle from its vertices and put them at the front of the cache
+		// 三角形をその頂点から取り除き、頂点をキャッシュの先頭に置く
+		nextCache.assign(triangle, triangle + 3);
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t v = triangle[k];
+			uint32_t* list = &adjacency[offsets[v]];
+			for (unsigned int j = 0; j < remaining[v]; j++)
+			{
+				if (list[j] == (uint32_t)best)
+				{
+					std::swap(list[j], list[remaining[v] - 1]);
+					remaining[v]--;
+					break;
+				}
+			}
+		}
+		for (uint32_t v : cache)
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				nextCache.push_back(v);
+
+		// Rescore every vertex that moved or fell out of the cache, and the triangles still using them
+		// 移動した頂点またはキャッシュから外れた頂点と、それを使う残りの三角形のスコアを付け直す
+		for (size_t i = 0; i < nextCache.size(); i++)
+		{
+			uint32_t v = nextCache[i];
+			cachePosition[v] = i < FORSYTH_CACHE_SIZE ? (int)i : -1;
+
+			float score = forsythScore(cachePosition[v], remaining[v]);
+			float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+			for (unsigned int j = 0; j < remaining[v]; j++)
+				triangleScore[adjacency[offsets[v] + j]] += delta;
+		}
+
+		if (nextCache.size() > FORSYTH_CACHE_SIZE)
+			nextCache.resize(FORSYTH_CACHE_SIZE);
+		std::swap(cache, nextCache);
+
+		// The next triangle is the best one touching the cache
+		// 次の三角形は、キャッシュに接する中で最もスコアの高い三角形
+		best = -1;
+		bestScore = -1.0f;
+		for (uint32_t v : cache)
+		{
+			for (unsigned int j = 0; j < remaining[v]; j++)
+			{
+				uint32_t t = adjacency[offsets[v] + j];
+				if (triangleScore[t] > bestScore)
+				{
+					best = (long)t;
+					bestScore = triangleScore[t];
+				}
+			}
+		}
+	}
+
+	indices = std::move(result);
+}
+
+// Splits the cache-ordered triangles into clusters and draws the clusters that face away from the mesh's centre
+// first, so they tend to occlude the rest (Sander et al., "Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw"). Clusters end where the cache restarts anyway, or where ending them costs at most
+// OVERDRAW_THRESHOLD of the cluster's ACMR, so the vertex cache order is kept.
+// キャッシュ順の三角形をクラスタに分け、メッシュの中心から外を向くクラスタを先に描くことで、残りを隠しやすくする
+// （Sanderら「Fast Triangle Reordering for Vertex Locality and Reduced Overdraw」）。クラスタはキャッシュが
+// どのみち最初からやり直す所か、区切ってもクラスタのACMRの悪化がOVERDRAW_THRESHOLD以内の所で終わるため、
+// 頂点キャッシュの順序は保たれる
+static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount < 2)
+		return;
+
+	std::vector<unsigned int> timestamps(vertices.size(), 0);
+	unsigned int time = VERTEX_CACHE_SIZE + 1;
+
+	// Hard boundaries: triangles whose three vertices all miss, where the cache effectively starts over
+	// 固い境界：3頂点すべてがミスする三角形（そこでキャッシュは実質的に最初からやり直す）
+	std::vector<size_t> hard;
+	for (size_t t = 0; t < triangleCount; t++)
+		if (fifoTriangle(&indices[t * 3], timestamps, time, VERTEX_CACHE_SIZE) == 3)
+			hard.push_back(t);
+	hard.push_back(triangleCount);
+
+	// Soft boundaries: split each hard cluster wherever its running ACMR has come down to its overall ACMR
+	// 柔らかい境界：各固いクラスタを、途中までのACMRが全体のACMRまで下がった所で分割する
+	std::vector<size_t> clusters;
+	for (size_t c = 0; c + 1 < hard.size(); c++)
+	{
+		size_t start = hard[c];
+		size_t end = hard[c + 1];
+
+		time += VERTEX_CACHE_SIZE + 1;
+		unsigned int clusterMisses = 0;
+		for (size_t t = start; t < end; t++)
+			clusterMisses += fifoTriangle(&indices[t * 3], timestamps, time, VERTEX_CACHE_SIZE);
+		float threshold = OVERDRAW_THRESHOLD * (float)clusterMisses / (float)(end - start);
+
+		clusters.push_back(start);
+		time += VERTEX_CACHE_SIZE + 1;
+		unsigned int runningMisses = 0;
+		unsigned int runningTriangles = 0;
+		for (size_t t = start; t < end; t++)
+		{
+			runningMisses += fifoTriangle(&indices[t * 3], timestamps, time, VERTEX_CACHE_SIZE);
+			runningTriangles++;
+
+			if (t + 1 < end && (float)runningMisses / (float)runningTriangles <= threshold)
+			{
+				clusters.push_back(t + 1);
+				time += VERTEX_CACHE_SIZE + 1;
+				runningMisses = 0;
+				runningTriangles = 0;
+			}
+		}
+	}
+	clusters.push_back(triangleCount);
+
+	// Area-weighted centroid of the mesh
+	// メッシュの面積で重み付けした重心
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		const glm::vec3& a = vertices[indices[t * 3]].position;
+		const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+		const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+		float area = glm::length(glm::cross(b - a, c - a));
+		meshCentroid += (a + b + c) * (area / 3.0f);
+		meshArea += area;
+	}
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+
+	// Sort key of a cluster: how far its centroid lies along its average normal, measured from the mesh's centroid
+	// クラスタの並べ替えキー（メッシュの重心から見て、クラスタの重心が平均法線の方向にどれだけ離れているか）
+	struct Cluster
+	{
+		size_t start;
+		size_t end;
+		float key;
+	};
+	std::vector<Cluster> sorted;
+	for (size_t c = 0; c + 1 < clusters.size(); c++)
+	{
+		glm::vec3 centroid(0.0f);
+		glm::vec3 normal(0.0f);
+		float area = 0.0f;
+		for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+		{
+			const glm::vec3& a = vertices[indices[t * 3]].position;
+			const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+			const glm::vec3& v = vertices[indices[t * 3 + 2]].position;
+			glm::vec3 faceNormal = glm::cross(b - a, v - a);
+			float faceArea = glm::length(faceNormal);
+			centroid += (a + b + v) * (faceArea / 3.0f);
+			normal += faceNormal;
+			area += faceArea;
+		}
+		if (area > 0.0f)
+			centroid /= area;
+		float length = glm::length(normal);
+		if (length > 0.0f)
+			normal /= length;
+
+		sorted.push_back({ clusters[c], clusters[c + 1], glm::dot(centroid - meshCentroid, normal) });
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const Cluster& cluster : sorted)
+		result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+	indices = std::move(result);
+}
+
+// Renumbers vertices in the order the index buffer first uses them, dropping vertices it never uses
+// インデックスバッファが最初に使う順に頂点の番号を付け直す（使われない頂点は取り除く）
+static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	const uint32_t UNUSED = ~(uint32_t)0;
+	std::vector<uint32_t> remap(vertices.size(), UNUSED);
+	std::vector<Vertex> ordered;
+	ordered.reserve(vertices.size());
+
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == UNUSED)
+		{
+			remap[index] = (uint32_t)ordered.size();
+			ordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+
+	vertices = std::move(ordered);
+}
+
+// Collapses every vertex into one representative per grid cell (vertices facing different ways are kept
+// apart so the two sides of a thin mesh do not merge) and keeps the triangles that still have three corners.
+// Returns how far the farthest vertex moved.
+// すべての頂点をグリッドのセルごとに1つの代表頂点にまとめ（薄いメッシュの表裏が融合しないよう、
+// 向きの異なる頂点は分けておく）、まだ3つの角を持つ三角形を残す。最も遠くに動いた頂点の移動距離を返す
+static float clusterVertices(const std::vector<Vertex>& vertices, const uint32_t* indices, size_t indexCount, glm::vec3 origin, float cellSize, std::vector<uint32_t>& result)
+{
+	const uint32_t UNUSED = ~(uint32_t)0;
+
+	// Cell and facing of each vertex: the grid coordinates and the sign and axis of the normal's largest component
+	// 各頂点のセルと向き（グリッド座標と、法線の最大成分の軸と符号）
+	std::unordered_map<uint64_t, uint32_t> clusterIds;
+	std::vector<uint32_t> cluster(vertices.size(), UNUSED);
+	std::vector<glm::vec3> sums;
+	std::vector<unsigned int> counts;
+	for (size_t i = 0; i < indexCount; i++)
+	{
+		uint32_t v = indices[i];
+		if (cluster[v] != UNUSED)
+			continue;
+
+		const Vertex& vertex = vertices[v];
+		uint64_t key = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			uint64_t cell = (uint64_t)std::max(0.0f, (vertex.position[axis] - origin[axis]) / cellSize);
+			key = (key << 20) | std::min(cell, (uint64_t)0xFFFFF);
+		}
+
+		int facing = 0;
+		for (int axis = 1; axis < 3; axis++)
+			if (std::abs(vertex.normal[axis]) > std::abs(vertex.normal[facing]))
+				facing = axis;
+		key = (key << 3) | (uint64_t)(facing * 2 + (vertex.normal[facing] < 0.0f ? 1 : 0));
+
+		auto inserted = clusterIds.emplace(key, (uint32_t)sums.size());
+		if (inserted.second)
+		{
+			sums.push_back(glm::vec3(0.0f));
+			counts.push_back(0);
+		}
+		cluster[v] = inserted.first->second;
+		sums[cluster[v]] += vertex.position;
+		counts[cluster[v]]++;
+	}
+
+	// The representative of a cluster is its vertex closest to the cluster's mean, so it keeps real attributes
+	// クラスタの代表はクラスタの平均に最も近い頂点（実在する属性をそのまま保つため）
+	std::vector<uint32_t> representative(sums.size(), UNUSED);
+	std::vector<float> closest(sums.size(), std::numeric_limits<float>::max());
+	for (uint32_t v = 0; v < (uint32_t)vertices.size(); v++)
+	{
+		if (cluster[v] == UNUSED)
+			continue;
+
+		glm::vec3 mean = sums[cluster[v]] / (float)counts[cluster[v]];
+		float distance = glm::length(vertices[v].position - mean);
+		if (distance < closest[cluster[v]])
+		{
+			closest[cluster[v]] = distance;
+			representative[cluster[v]] = v;
+		}
+	}
+
+	float error = 0.0f;
+	for (uint32_t v = 0; v < (uint32_t)vertices.size(); v++)
+		if (cluster[v] != UNUSED)
+			error = std::max(error, glm::length(vertices[v].position - vertices[representative[cluster[v]]].position));
+
+	// Keep triangles whose corners landed in three different clusters, once each (rotated, not reordered, to compare)
+	// 角が3つの異なるクラスタに入った三角形を1つずつ残す（比較のため回転させるが、向きは変えない）
+	std::set<std::array<uint32_t, 3>> seen;
+	result.clear();
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		std::array<uint32_t, 3> triangle = { representative[cluster[indices[i]]], representative[cluster[indices[i + 1]]], representative[cluster[indices[i + 2]]] };
+		if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+			continue;
+
+		std::array<uint32_t, 3> rotated = triangle;
+		while (rotated[0] > rotated[1] || rotated[0] > rotated[2])
+			rotated = { rotated[1], rotated[2], rotated[0] };
+		if (seen.insert(rotated).second)
+			result.insert(result.end(), triangle.begin(), triangle.end());
+	}
+
+	return error;
+}
+
+// Builds a quad on each side of a flat mesh, covering its bounds, with texture coordinates fitted to the vertices
+// facing that side (a flat face is mapped affinely, so the fit is exact for a card). Returns false if a side has
+// no face or the fit does not hold.
+// 平らなメッシュの各面に、範囲を覆う四角形を作る（テクスチャ座標はその面を向く頂点に合わせる。平らな面は
+// アフィンにマッピングされるため、カードでは完全に一致する）。面の無い側があるか、合わせられない場合はfalseを返す
+static bool buildImpostor(std::vector<Vertex>& vertices, int axis, glm::vec3 boundsMin, glm::vec3 boundsMax, std::vector<uint32_t>& result, float& error)
+{
+	int axisU = (axis + 1) % 3;
+	int axisV = (axis + 2) % 3;
+	size_t sourceCount = vertices.size();
+
+	std::vector<Vertex> quads;
+	float heights[2];
+	for (int side = 0; side < 2; side++)
+	{
+		float sign = side == 0 ? 1.0f : -1.0f;
+
+		// Least-squares affine fit of the texture coordinates over the vertices facing this side
+		// この面を向く頂点に対する、テクスチャ座標の最小二乗アフィン近似
+		glm::mat3 normal(0.0f);
+		glm::vec3 rhsU(0.0f);
+		glm::vec3 rhsV(0.0f);
+		float height = 0.0f;
+		unsigned int count = 0;
+		for (size_t i = 0; i < sourceCount; i++)
+		{
+			const Vertex& vertex = vertices[i];
+			if (vertex.normal[axis] * sign < 0.9f)
+				continue;
+
+			glm::vec3 row(vertex.position[axisU], vertex.position[axisV], 1.0f);
+			for (int c = 0; c < 3; c++)
+				normal[c] += row * row[c];
+			rhsU += row * vertex.texUV.x;
+			rhsV += row * vertex.texUV.y;
+			height += vertex.position[axis];
+			count++;
+		}
+		if (count < 3 || std::abs(glm::determinant(normal)) < 1e-12f)
+			return false;
+
+		glm::mat3 inverse = glm::inverse(normal);
+		glm::vec3 fitU = inverse * rhsU;
+		glm::vec3 fitV = inverse * rhsV;
+		heights[side] = height / (float)count;
+
+		for (size_t i = 0; i < sourceCount; i++)
+		{
+			const Vertex& vertex = vertices[i];
+			if (vertex.normal[axis] * sign < 0.9f)
+				continue;
+
+			glm::vec3 row(vertex.position[axisU], vertex.position[axisV], 1.0f);
+			if (std::abs(glm::dot(fitU, row) - vertex.texUV.x) > IMPOSTOR_UV_TOLERANCE ||
+				std::abs(glm::dot(fitV, row) - vertex.texUV.y) > IMPOSTOR_UV_TOLERANCE)
+				return false;
+		}
+
+		// Corners counter-clockwise around the axis; texture coordinates are clamped since rounded
+		// corners leave the bounds' corners outside the texture
+		// 軸の周りに反時計回りの角（角が丸い場合は範囲の角がテクスチャの外に出るため、テクスチャ座標は制限する）
+		const float cornerU[4] = { boundsMin[axisU], boundsMax[axisU], boundsMax[axisU], boundsMin[axisU] };
+		const float cornerV[4] = { boundsMin[axisV], boundsMin[axisV], boundsMax[axisV], boundsMax[axisV] };
+		for (int c = 0; c < 4; c++)
+		{
+			glm::vec3 row(cornerU[c], cornerV[c], 1.0f);
+
+			Vertex corner;
+			corner.position[axis] = heights[side];
+			corner.position[axisU] = cornerU[c];
+			corner.position[axisV] = cornerV[c];
+			corner.normal = glm::vec3(0.0f);
+			corner.normal[axis] = sign;
+			corner.texUV = glm::vec2(glm::clamp(glm::dot(fitU, row), 0.0f, 1.0f), glm::clamp(glm::dot(fitV, row), 0.0f, 1.0f));
+			quads.push_back(corner);
+		}
+	}
+
+	// Error: vertices are measured to the nearer quad, and the quads' corners to the nearest vertex
+	// 誤差：頂点は近い方の四角形まで、四角形の角は最も近い頂点までの距離で測る
+	error = 0.0f;
+	for (size_t i = 0; i < sourceCount; i++)
+	{
+		float position = vertices[i].position[axis];
+		error = std::max(error, std::min(std::abs(position - heights[0]), std::abs(position - heights[1])));
+	}
+	for (const Vertex& corner : quads)
+	{
+		float nearest = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < sourceCount; i++)
+			nearest = std::min(nearest, glm::length(vertices[i].position - corner.position));
+		error = std::max(error, nearest);
+	}
+
+	// The back quad is wound the other way so it faces away from the axis
+	// 裏の四角形は軸と逆を向くよう、逆向きに巻く
+	uint32_t first = (uint32_t)sourceCount;
+	const uint32_t order[12] = { 0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6 };
+	result.clear();
+	for (uint32_t index : order)
+		result.push_back(first + index);
+	vertices.insert(vertices.end(), quads.begin(), quads.end());
+	return true;
+}
+
+MeshOptimizeReport optimize_mesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	MeshOptimizeReport report;
+	report.verticesBefore = vertices.size();
+	report.before = analyze_vertex_cache(indices, vertices.size());
+
+	// Only triangle lists can be reordered; anything else is left as it is
+	// 並べ替えられるのは三角形リストのみ（それ以外はそのまま残す）
+	if (indices.size() % 3 != 0)
+	{
+		report.verticesAfter = vertices.size();
+		report.after = report.before;
+		return report;
+	}
+
+	mergeVertices(vertices, indices);
+	optimizeVertexCache(indices, vertices.size());
+	optimizeOverdraw(indices, vertices);
+	optimizeVertexFetch(vertices, indices);
+
+	report.verticesAfter = vertices.size();
+	report.after = analyze_vertex_cache(indices, vertices.size());
+	return report;
+}
+
+MeshLodChain build_mesh_lods(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	MeshLodChain chain;
+	chain.count = 1;
+	chain.levels[0].indexCount = (uint32_t)indices.size();
+	if (vertices.empty() || indices.size() < 3 || indices.size() % 3 != 0)
+		return chain;
+
+	glm::vec3 boundsMin = vertices[0].position;
+	glm::vec3 boundsMax = vertices[0].position;
+	for (const Vertex& vertex : vertices)
+	{
+		boundsMin = glm::min(boundsMin, vertex.position);
+		boundsMax = glm::max(boundsMax, vertex.position);
+	}
+	chain.center = (boundsMin + boundsMax) * 0.5f;
+	chain.extents = (boundsMax - boundsMin) * 0.5f;
+	for (const Vertex& vertex : vertices)
+		chain.radius = std::max(chain.radius, glm::length(vertex.position - chain.center));
+
+	glm::vec3 extent = boundsMax - boundsMin;
+	float longest = std::max(extent.x, std::max(extent.y, extent.z));
+	if (longest <= 0.0f)
+		return chain;
+
+	// A flat mesh saves the last level for its impostor
+	// 平らなメッシュは最後のレベルをインポスター用に残す
+	int thinnest = 0;
+	for (int axis = 1; axis < 3; axis++)
+		if (extent[axis] < extent[thinnest])
+			thinnest = axis;
+	bool flat = extent[thinnest] <= IMPOSTOR_FLATNESS * std::min(extent[(thinnest + 1) % 3], extent[(thinnest + 2) % 3]);
+	unsigned int clusteredLevels = MAX_MESH_LODS - (flat ? 2 : 1);
+
+	// Cluster on finer grids first, keeping each level that is clearly smaller than the one before
+	// 細かいグリッドから順にクラスタリングし、1つ前より明らかに小さいレベルを残す
+	size_t baseCount = indices.size();
+	size_t previousTriangles = baseCount / 3;
+	std::vector<uint32_t> level;
+	for (unsigned int resolution : LOD_GRID_RESOLUTIONS)
+	{
+		if (chain.count > clusteredLevels)
+			break;
+
+		float error = clusterVertices(vertices, indices.data(), baseCount, boundsMin, longest / (float)resolution, level);
+		if (level.empty())
+			break;
+		if ((float)(level.size() / 3) > LOD_REDUCTION * (float)previousTriangles)
+			continue;
+
+		optimizeVertexCache(level, vertices.size());
+
+		MeshLod& lod = chain.levels[chain.count++];
+		lod.firstIndex = (uint32_t)indices.size();
+		lod.indexCount = (uint32_t)level.size();
+		lod.error = error;
+		indices.insert(indices.end(), level.begin(), level.end());
+		previousTriangles = level.size() / 3;
+	}
+
+	float error = 0.0f;
+	if (flat && buildImpostor(vertices, thinnest, boundsMin, boundsMax, level, error))
+	{
+		MeshLod& lod = chain.levels[chain.count++];
+		lod.firstIndex = (uint32_t)indices.size();
+		lod.indexCount = (uint32_t)level.size();
+		lod.error = error;
+		lod.impostor = true;
+		indices.insert(indices.end(), level.begin(), level.end());
+	}
+
+	return chain;
+}
\ No newline at end of file
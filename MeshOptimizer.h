@@ -0,0 +1,91 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "VertexLayout.h"
+
+// Size of the FIFO post-transform cache the statistics simulate (a conservative model of current GPUs)
+// 統計でシミュレートするFIFO変換後キャッシュのサイズ（現行GPUの控えめなモデル）
+static const unsigned int VERTEX_CACHE_SIZE = 16;
+
+// Post-transform vertex cache efficiency of an index buffer
+// ACMR is vertex shader runs per triangle (0.5 is ideal for large grids, 3 is the worst);
+// ATVR is vertex shader runs per vertex (1 is ideal)
+// インデックスバッファの変換後頂点キャッシュ効率
+// ACMRは三角形あたりの頂点シェーダー実行回数（大きなグリッドでは0.5が理想、3が最悪）
+// ATVRは頂点あたりの頂点シェーダー実行回数（1が理想）
+struct VertexCacheStats
+{
+	float acmr = 0.0f;
+	float atvr = 0.0f;
+};
+
+// What optimize_mesh did to a mesh
+// optimize_meshがメッシュに行ったこと
+struct MeshOptimizeReport
+{
+	size_t verticesBefore = 0;
+	size_t verticesAfter = 0;
+	VertexCacheStats before;
+	VertexCacheStats after;
+};
+
+// Most levels of detail a mesh can have, including the full mesh and the impostor
+// メッシュが持てる詳細度レベルの最大数（完全なメッシュとインポスターを含む）
+static const unsigned int MAX_MESH_LODS = 4;
+
+// One level of detail: a range of the mesh's index buffer drawn against the shared vertex buffer
+// 1つの詳細度レベル（共有の頂点バッファに対して描画する、メッシュのインデックスバッファの範囲）
+struct MeshLod
+{
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+
+	// Farthest a point of the level lies from the full mesh, in mesh units (0 for the full mesh)
+	// レベル上の点が完全なメッシュから最も離れている距離（メッシュ単位。完全なメッシュでは0）
+	float error = 0.0f;
+
+	// Set on the flat textured quads that stand in for a distant flat mesh
+	// 遠くの平らなメッシュの代わりになる、テクスチャ付きの平らな四角形で設定される
+	bool impostor = false;
+};
+
+// Levels of detail of a mesh, finest first, with the bounding sphere used to measure their screen size
+// and cull the mesh, and the half size of the bounding box around the same center
+// メッシュの詳細度レベル（細かい順）と、画面上の大きさの計測とカリングに使うバウンディング球、
+// および同じ中心を持つバウンディングボックスの半分の大きさ
+struct MeshLodChain
+{
+	unsigned int count = 0;
+	MeshLod levels[MAX_MESH_LODS];
+
+	glm::vec3 center = glm::vec3(0.0f, 0.0f, 0.0f);
+	float radius = 0.0f;
+	glm::vec3 extents = glm::vec3(0.0f, 0.0f, 0.0f);
+};
+
+// Simulates a FIFO cache of cacheSize entries over a triangle list
+// 三角形リストに対してcacheSize個のエントリを持つFIFOキャッシュをシミュレートする
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t>& indices, size_t vertexCount, unsigned int cacheSize = VERTEX_CACHE_SIZE);
+
+// Optimizes a triangle list in place, in order: merges identical vertices, orders triangles for the vertex cache
+// (Forsyth), regroups them so outward-facing patches draw first (overdraw), then renumbers vertices in the
+// order they are first used (fetch locality). Unreferenced vertices are dropped; the mesh draws the same.
+// 三角形リストをその場で最適化する（順に：同一頂点の統合、頂点キャッシュのための三角形の並べ替え（Forsyth）、
+// 外向きの面のまとまりが先に描かれるような再グループ化（オーバードロー）、最初に使われる順での頂点の番号付け直し
+// （フェッチの局所性））。参照されない頂点は取り除かれ、描画結果は変わらない
+MeshOptimizeReport optimize_mesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+// Builds coarser levels of detail of an optimized triangle list by vertex clustering and, if the mesh is flat,
+// a two-sided quad impostor whose texture coordinates are fitted to the mesh's faces. The levels' indices
+// are appended to indices (the impostor's vertices to vertices), so every level shares one vertex and one
+// index buffer; level 0 is the original list.
+// 頂点クラスタリングで最適化済みの三角形リストのより粗い詳細度レベルを作り、メッシュが平らであれば、
+// テクスチャ座標をメッシュの面に合わせた両面の四角形インポスターも作る。各レベルのインデックスはindicesに
+// （インポスターの頂点はverticesに）追加されるため、すべてのレベルが1つの頂点バッファと1つのインデックス
+// バッファを共有する（レベル0は元のリスト）
+MeshLodChain build_mesh_lods(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+#endif
\ No newline at end of file
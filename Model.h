@@ -1,12 +1,27 @@
 #ifndef MODEL_CLASS_H
 #define MODEL_CLASS_H
 
-#include <json/json.h>
 #include "Mesh.h"
+#include "GeometryCache.h"
+#include "ModelData.h"
+#include "CardPack.h"
+#include "TextureStreamer.h"
+#include "TextureArray.h"
+
+// CPU copies a model keeps once its data is on the GPU (flags; everything else is freed after upload)
+// データがGPUに転送された後もモデルが保持するCPU側コピー（フラグ。それ以外は転送後に解放される）
+enum CpuRetention : unsigned int
+{
+	RETAIN_NOTHING = 0,
+
+	// Float vertices and indices of every mesh, for picking against triangles or for tooling
+	// 三角形に対するピッキングやツール用の、各メッシュの浮動小数点の頂点とインデックス
+	RETAIN_GEOMETRY = 1,
 
-// Alias nlohmann::json to json for convenience
-// 利便性のために nlohmann::json を json という別名で使用する
-using json = nlohmann::json;
+	// Decoded texture pixels, needed to re-create textures after eviction (card pack pixels are always available)
+	// 退避後にテクスチャを再作成するのに必要なデコード済みピクセル（カードパックのピクセルは常に利用できる）
+	RETAIN_PIXELS = 2
+};
 
 // Model class responsible for loading and rendering a 3D model
 // 3Dモデルの読み込みと描画を担当するModelクラス
@@ -14,100 +29,171 @@ class Model
 {
 public:
 
+	// Pixels a texture is created from: decoded images kept in memory, or a mip chain in a mapped card pack
+	// テクスチャの作成元のピクセル（メモリに保持したデコード済み画像、またはマッピングされたカードパック内のミップチェーン）
+	struct TextureSource
+	{
+		TextureImage image;
+		std::shared_ptr<const void> owner;
+		const char* type;
+	};
+
+	// Constructor that creates an empty model, filled in later by Upload (e.g. while streaming)
+	// 空のモデルを作成するコンストラクタ（後でUploadで中身を入れる。例：ストリーミング中）
+	Model() = default;
+
 	// Constructor that loads a model from file path
+	// Meshes whose geometry is already in geometryCache reuse the GPU buffers there
 	// ファイルパスからモデルを読み込むコンストラクタ
-	Model(const char* file);
-
-	// Draws the model using the provided shader and camera
-	// 指定されたシェーダーとカメラを使ってモデルを描画する
-	void Draw(Shader& shader, Camera& camera);
+	// geometryCacheに既にあるジオメトリのメッシュはそのGPUバッファを再利用する
+	Model(const char* file, GeometryCache* geometryCache = nullptr, CpuRetention retention = RETAIN_NOTHING);
+
+	// Constructor that uploads a model already decoded on the CPU (e.g. by a worker thread)
+	// CPUで（例：ワーカースレッドで）デコード済みのモデルを転送するコンストラクタ
+	Model(ModelData& data, GeometryCache* geometryCache = nullptr, CpuRetention retention = RETAIN_NOTHING);
+
+	// Constructor that uploads a model cooked into a card pack, with no parsing or decoding
+	// カードパックに調理済みのモデルを、解析やデコード無しで転送するコンストラクタ
+	Model(const CardPack& pack, const CardPackModel& entry, GeometryCache* geometryCache = nullptr);
+
+	// Uploads the meshes of decoded model data and keeps its images for CreateTextures
+	// retention says which CPU copies survive the upload (lazily textured models need RETAIN_PIXELS)
+	// デコード済みのモデルデータのメッシュを転送し、画像をCreateTextures用に保持する
+	// retentionは転送後も残すCPU側コピーを指定する（遅延テクスチャのモデルにはRETAIN_PIXELSが必要）
+	void Upload(ModelData& data, GeometryCache* geometryCache = nullptr, CpuRetention retention = RETAIN_NOTHING);
+
+	// Uploads the meshes of a model cooked into a card pack and remembers where its textures are
+	// カードパックに調理済みのモデルのメッシュを転送し、テクスチャの場所を記録する
+	void Upload(const CardPack& pack, const CardPackModel& entry, GeometryCache* geometryCache = nullptr);
+
+	// Creates the textures from the sources kept by Upload (the constructors do this right away)
+	// With a streamer the pixels arrive over the next frames. Without RETAIN_PIXELS the decoded pixels
+	// are freed afterwards, and creating the textures again throws std::logic_error.
+	// Uploadが保持したソースからテクスチャを作成する（コンストラクタはすぐにこれを行う）
+	// ストリーマーがある場合、ピクセルは以降のフレームで届く。RETAIN_PIXELSが無い場合はその後
+	// デコード済みのピクセルを解放し、テクスチャを再び作成するとstd::logic_errorを投げる
+	void CreateTextures(TextureStreamer* streamer = nullptr);
+
+	// Deletes the textures to free GPU memory; CreateTextures brings them back
+	// Returns false if a streamer is still filling them
+	// GPUメモリを解放するためにテクスチャを削除する（CreateTexturesで元に戻せる）
+	// ストリーマーがまだ埋めている途中の場合はfalseを返す
+	bool ReleaseTextures();
+
+	// Returns the images the textures are created from
+	// テクスチャの作成元の画像を返す
+	inline const std::vector<TextureSource>& GetTextureSources() const { return textureSources; }
+
+	// Returns the single image a card face layer can be filled from, or nullptr if the model has several
+	// カードの表面レイヤーを埋める唯一の画像を返す（モデルに複数ある場合はnullptr）
+	inline const TextureSource* GetFaceSource() const { return textureSources.size() == 1 ? &textureSources[0] : nullptr; }
+
+	// Draws the model's only texture from a layer of the shared face array instead of its own texture
+	// With a streamer the pixels arrive over the next frames
+	// モデル唯一のテクスチャを、自身のテクスチャではなく共有の表面配列のレイヤーから描画する
+	// ストリーマーがある場合、ピクセルは以降のフレームで届く
+	void CreateFaceLayer(TextureArray& faces, int layer, TextureStreamer* streamer = nullptr);
+
+	// Gives the face layer back; returns false if a streamer is still filling it
+	// 表面レイヤーを返す（ストリーマーがまだ埋めている途中の場合はfalseを返す）
+	bool ReleaseFaceLayer();
+
+	// Returns the face array layer the model is drawn with, or -1 if it uses its own textures
+	// モデルの描画に使う表面配列のレイヤーを返す（自身のテクスチャを使う場合は-1）
+	inline int GetFaceLayer() const { return faceLayer; }
+
+	// Returns the CPU memory held by the model and the GPU memory of its own textures
+	// モデルが保持するCPUメモリと、自身のテクスチャのGPUメモリ量を返す
+	MemoryUsage GetMemoryUsage() const;
+
+	// Returns the GPU memory the textures take while created
+	// テクスチャが作成されている間に使用するGPUメモリ量を返す
+	size_t GetTextureBytes() const;
+
+	// Returns true while the pixels needed to create the textures are still held
+	// テクスチャの作成に必要なピクセルをまだ保持していればtrueを返す
+	inline bool HasPixels() const { return !pixelsReleased; }
+
+	// Returns true once Upload has created the meshes
+	// Uploadがメッシュを作成していればtrueを返す
+	inline bool IsUploaded() const { return uploaded; }
+
+	// Returns true if the textures or a face layer are created (possibly still streaming)
+	// テクスチャまたは表面レイヤーが作成されていればtrueを返す（ストリーミング中の場合もある）
+	inline bool HasTextures() const { return texturesCreated || faceLayer >= 0; }
+
+	// Returns true once the meshes are uploaded and every texture is complete
+	// メッシュが転送され、すべてのテクスチャが完成していればtrueを返す
+	inline bool IsResident() const { return uploaded && HasTextures() && pendingTextures == 0; }
+
+	// Returns the meshes and the node matrix each one is placed with (e.g. for instanced drawing)
+	// メッシュと、それぞれを配置するノードの行列を返す（例：インスタンス描画用）
+	inline const std::vector<Mesh>& GetMeshes() const { return meshes; }
+	inline const std::vector<glm::mat4>& GetMeshMatrices() const { return matricesMeshes; }
+
+	// Returns the sphere that bounds every mesh in model space: the node matrices are applied, the object transform
+	// and the mirror of Mesh::WorldMatrix are not, so it is drawn at Mesh::WorldMatrix(transform) times the center
+	// (radius 0 until Upload has created the meshes)
+	// モデル空間ですべてのメッシュを囲む球を返す（ノードの行列は適用済み、オブジェクトの変換とMesh::WorldMatrixの
+	// 反転は未適用のため、描画される位置はMesh::WorldMatrix(transform)×中心。Uploadがメッシュを作成するまで半径は0）
+	inline const glm::vec3& GetBoundsCenter() const { return boundsCenter; }
+	inline float GetBoundsRadius() const { return boundsRadius; }
+
+	// Returns the textures the model's meshes are drawn with (empty while evicted or drawn from a face layer)
+	// モデルのメッシュの描画に使うテクスチャを返す（退避中または表面レイヤーから描画する場合は空）
+	inline std::vector<Texture>& GetTextures() { return textures; }
 
 private:
 
-	// Path to the model file
-	// モデルファイルへのパス
-	const char* file;
+	// Set once Upload has created the meshes
+	// Uploadがメッシュを作成するとセットされる
+	bool uploaded = false;
+
+	// CPU copies kept after upload, and whether decoded pixels have already been freed
+	// 転送後に保持するCPU側コピーと、デコード済みのピクセルが既に解放されたかどうか
+	CpuRetention retention = RETAIN_NOTHING;
+	bool pixelsReleased = false;
+
+	// Set while the textures exist on the GPU
+	// テクスチャがGPU上に存在する間セットされる
+	bool texturesCreated = false;
 
-	// Raw binary buffer data from the model file
-	// モデルファイルから取得した生のバイナリバッファデータ
-	std::vector<unsigned char> data;
+	// Layer of the shared face array, or -1
+	// 共有の表面配列のレイヤー（無い場合は-1）
+	int faceLayer = -1;
 
-	// Parsed JSON structure of the glTF file
-	// glTFファイルを解析したJSON構造
-	json JSON;
+	// Number of textures still waiting in a TextureStreamer
+	// TextureStreamerでまだ待っているテクスチャの数
+	unsigned int pendingTextures = 0;
 
 	// Collection of meshes that make up the model
 	// モデルを構成するMeshの集合
 	std::vector<Mesh> meshes;
 
-	// Per-mesh translation vectors
-	// 各メッシュごとの平行移動ベクトル
-	std::vector<glm::vec3> translationsMeshes;
-
-	// Per-mesh rotation quaternions
-	// 各メッシュごとの回転（クォータニオン）
-	std::vector<glm::quat> rotationsMeshes;
-
-	// Per-mesh scale vectors
-	// 各メッシュごとのスケールベクトル
-	std::vector<glm::vec3> scalesMeshes;
-
 	// Final transformation matrices for each mesh
 	// 各メッシュの最終的な変換行列
 	std::vector<glm::mat4> matricesMeshes;
 
-	// Names of textures that have already been loaded (to avoid duplicates)
-	// 重複を防ぐため、すでに読み込まれたテクスチャ名
-	std::vector<std::string> loadedTexName;
-
-	// Loaded texture objects
-	// 読み込まれたテクスチャオブジェクト
-	std::vector<Texture> loadedTex;
-
-	// Loads a mesh from the JSON using its index
-	// インデックスを使ってJSONからメッシュを読み込む
-	void loadMesh(unsigned int indMesh);
-
-	// Recursively traverses a node in the scene graph and applies transformations
-	// シーングラフ内のノードを再帰的に巡回し、変換を適用する
-	void traverseNode(unsigned int nextNode, glm::mat4 matrix = glm::mat4(1.0f));
-
-	// Retrieves raw binary buffer data from the model file
-	// モデルファイルから生のバイナリバッファデータを取得する
-	std::vector<unsigned char> getData();
-
-	// Extracts floating-point attribute data from an accessor
-	// アクセサから浮動小数点の属性データを抽出する
-	std::vector<float> getFloats(json accessor);
-
-	// Extracts index data from an accessor
-	// アクセサからインデックスデータを抽出する
-	std::vector<GLuint> getIndices(json accessor);
-
-	// Loads textures defined in the model file
-	// モデルファイルで定義されたテクスチャを読み込む
-	std::vector<Texture> getTextures();
-
-	// Combines positions, normals, and UVs into Vertex objects
-	// 位置・法線・UVを組み合わせてVertexオブジェクトを作成する
-	std::vector<Vertex> assembleVertices
-	(
-		std::vector<glm::vec3> positions,
-		std::vector<glm::vec3> normals,
-		std::vector<glm::vec2> texUVs
-	);
-
-	// Groups a flat float array into vec2 structures
-	// フラットなfloat配列をvec2構造にまとめる
-	std::vector<glm::vec2> groupFloatsVec2(std::vector<float> floatVec);
-
-	// Groups a flat float array into vec3 structures
-	// フラットなfloat配列をvec3構造にまとめる
-	std::vector<glm::vec3> groupFloatsVec3(std::vector<float> floatVec);
-
-	// Groups a flat float array into vec4 structures
-	// フラットなfloat配列をvec4構造にまとめる
-	std::vector<glm::vec4> groupFloatsVec4(std::vector<float> floatVec);
+	// Sphere around every mesh in model space (see GetBoundsCenter)
+	// モデル空間ですべてのメッシュを囲む球（GetBoundsCenterを参照）
+	glm::vec3 boundsCenter = glm::vec3(0.0f, 0.0f, 0.0f);
+	float boundsRadius = 0.0f;
+
+	// Images the textures are created from
+	// テクスチャの作成元の画像
+	std::vector<TextureSource> textureSources;
+
+	// Textures shared by every mesh of the model (owned here and bound by the render queue per material)
+	// モデルのすべてのメッシュで共有されるテクスチャ（ここで所有し、レンダーキューがマテリアルごとにバインドする）
+	std::vector<Texture> textures;
+
+	// Builds the model's bounding sphere from the spheres of its meshes (called by Upload)
+	// 各メッシュの球からモデルのバウンディング球を作る（Uploadが呼ぶ）
+	void computeBounds();
+
+	// Frees decoded pixels once the textures no longer need them
+	// テクスチャに不要になったデコード済みピクセルを解放する
+	void releasePixels();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "ModelCache.h"
+
+#include <chrono>
+#include <filesystem>
+#include "Profiling.h"
+
+// Returns a shared model, decoding it only when no live copy exists
+// 生存中のコピーが無い場合のみデコードし、共有モデルを返す
+std::shared_ptr<Model> ModelCache::Load(const char* file, CpuRetention retention)
+{
+	return LoadAll(&file, 1, retention)[0];
+}
+
+// Loads a batch of models in two phases: CPU decoding on the pool, then GL upload on this thread
+// モデルの一括読み込みを2つのフェーズで行う：プールでのCPUデコード、その後このスレッドでのGL転送
+std::vector<std::shared_ptr<Model>> ModelCache::LoadAll(const char* const files[], unsigned int count, CpuRetention retention)
+{
+	retention = (CpuRetention)(retention | ModelCache::retention);
+
+	std::vector<std::shared_ptr<Model>> loaded(count);
+
+	// Models this batch has to load, by position in files
+	// このバッチで読み込む必要があるモデル（filesでの位置）
+	struct Pending
+	{
+		unsigned int index;
+		std::string key;
+		const CardPackModel* cooked;
+		std::future<ModelData> data;
+		Milliseconds decodeTime;
+	};
+	std::vector<Pending> pending;
+
+	// Workers write decodeTime into these entries, so they must never move
+	// ワーカーがdecodeTimeを書き込むため、エントリは移動してはならない
+	pending.reserve(count);
+	std::unordered_map<std::string, unsigned int> batchKeys;
+
+	// CPU phase: queue a decode for every model that is neither live nor cooked
+	// CPUフェーズ：生存中でも調理済みでもないすべてのモデルのデコードをキューに入れる
+	Clock::time_point start = Clock::now();
+	for (unsigned int i = 0; i < count; i++)
+	{
+		std::string key = canonicalPath(files[i]);
+
+		// Reuse the model if another card still holds it
+		// 他のカードがまだ保持している場合はモデルを再利用する
+		auto found = models.find(key);
+		if (found != models.end())
+		{
+			loaded[i] = found->second.lock();
+			if (loaded[i])
+			{
+				cacheHits++;
+				continue;
+			}
+		}
+
+		// The same file listed twice in one batch is loaded once
+		// 1つのバッチに2回現れる同じファイルは一度だけ読み込む
+		if (batchKeys.count(key))
+			continue;
+		batchKeys[key] = i;
+
+		pending.push_back(Pending());
+		Pending& load = pending.back();
+		load.index = i;
+		load.key = key;
+
+		// Prefer the cooked copy in the card pack, which needs no parsing or decoding
+		// 解析やデコードが不要な、カードパック内の調理済みのコピーを優先する
+		load.cooked = pack.IsOpen() ? pack.Find(files[i]) : nullptr;
+		if (!load.cooked)
+		{
+			std::string file = files[i];
+			Milliseconds* decodeTime = &load.decodeTime;
+			load.data = pool.Submit([file, decodeTime]()
+			{
+				Clock::time_point begin = Clock::now();
+				ModelData data(file.c_str());
+				*decodeTime = Clock::now() - begin;
+				return data;
+			});
+		}
+	}
+
+	// Wait for every decode (get rethrows any exception from the worker)
+	// すべてのデコードを待つ（getはワーカーで発生した例外を再送出する）
+	for (Pending& load : pending)
+		if (load.data.valid())
+			load.data.wait();
+	Clock::time_point decoded = Clock::now();
+
+	// GL phase: upload on this thread, which owns the context
+	// GLフェーズ：コンテキストを所有するこのスレッドで転送する
+	for (Pending& load : pending)
+	{
+		Clock::time_point begin = Clock::now();
+		std::shared_ptr<Model> model;
+		if (load.cooked)
+		{
+			model = std::make_shared<Model>(pack, *load.cooked, &geometryCache);
+		}
+		else
+		{
+			ModelData data = load.data.get();
+			model = std::make_shared<Model>(data, &geometryCache, retention);
+		}
+		Milliseconds uploadTime = Clock::now() - begin;
+
+		loaded[load.index] = model;
+		models[load.key] = model;
+		loadCounts[load.key]++;
+		totalLoads++;
+
+		std::cout << "Loaded " << load.key << (load.cooked ? " from card pack" : "") << ": "
+			<< load.decodeTime.count() << " ms decode, " << uploadTime.count() << " ms upload" << std::endl;
+	}
+	Clock::time_point uploaded = Clock::now();
+
+	// Fill in files that appeared more than once in the batch
+	// バッチ内に複数回現れたファイルを埋める
+	for (unsigned int i = 0; i < count; i++)
+		if (!loaded[i])
+			loaded[i] = models[canonicalPath(files[i])].lock();
+
+	// Report the wall-clock time of each phase; decode time summed over threads shows the parallel win
+	// 各フェーズの実時間を報告する（スレッド合計のデコード時間と比べると並列化の効果がわかる）
+	if (!pending.empty())
+	{
+		Milliseconds decodeSum(0);
+		for (Pending& load : pending)
+			decodeSum += load.decodeTime;
+
+		std::cout << "Loaded " << pending.size() << " models: CPU phase " << Milliseconds(decoded - start).count()
+			<< " ms (" << decodeSum.count() << " ms of decoding on " << pool.GetThreadCount() << " threads), GL phase "
+			<< Milliseconds(uploaded - decoded).count() << " ms (peak RSS "
+			<< get_peak_resident_bytes() / (1024 * 1024) << " MB)" << std::endl;
+	}
+
+	return loaded;
+}
+
+// Registers an empty model right away and loads it in the background over the next frames
+// 空のモデルをすぐに登録し、以降のフレームでバックグラウンドに読み込む
+std::shared_ptr<Model> ModelCache::Stream(const char* file, bool lazyTextures)
+{
+	std::string key = canonicalPath(file);
+
+	// Reuse the model if it is live, even if it is still streaming
+	// 生存中であれば、ストリーミング中でもモデルを再利用する
+	auto found = models.find(key);
+	if (found != models.end())
+	{
+		std::shared_ptr<Model> model = found->second.lock();
+		if (model)
+		{
+			cacheHits++;
+			return model;
+		}
+	}
+
+	streaming.push_back(Streaming());
+	Streaming& load = streaming.back();
+	load.key = key;
+	load.model = std::make_shared<Model>();
+	load.lazyTextures = lazyTextures;
+	load.requested = Clock::now();
+	models[key] = load.model;
+
+	// Cooked models need no decoding, so they are uploaded on the next Update
+	// 調理済みモデルはデコード不要のため、次のUpdateで転送される
+	load.cooked = pack.IsOpen() ? pack.Find(file) : nullptr;
+	if (!load.cooked)
+	{
+		std::string path = file;
+		Milliseconds* decodeTime = &load.decodeTime;
+		load.data = pool.Submit([path, decodeTime]()
+		{
+			Clock::time_point begin = Clock::now();
+			ModelData data(path.c_str());
+			*decodeTime = Clock::now() - begin;
+			return data;
+		});
+	}
+
+	return load.model;
+}
+
+// Moves streamed models along: upload decoded ones, stream texture rows, retire resident ones
+// ストリーミング中のモデルを進める：デコード済みのものを転送し、テクスチャの行を流し、常駐したものを外す
+void ModelCache::Update()
+{
+	for (auto it = streaming.begin(); it != streaming.end();)
+	{
+		Streaming& load = *it;
+
+		// Upload the meshes as soon as the decode is ready; textures go through the streamer
+		// デコードが終わり次第メッシュを転送する（テクスチャはストリーマーを通す）
+		if (!load.uploaded)
+		{
+			if (load.cooked)
+			{
+				load.model->Upload(pack, *load.cooked, &geometryCache);
+				load.uploaded = true;
+			}
+			else if (load.data.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				// Lazily textured models are re-textured after every eviction, so they keep their pixels
+				// 遅延テクスチャのモデルは退避のたびにテクスチャを作り直すため、ピクセルを保持する
+				ModelData data = load.data.get();
+				load.model->Upload(data, &geometryCache, load.lazyTextures ? (CpuRetention)(retention | RETAIN_PIXELS) : retention);
+				load.uploaded = true;
+			}
+
+			// Lazy textures wait until the residency manager is asked for them
+			// 遅延テクスチャは常駐管理に要求されるまで待つ
+			if (load.uploaded && !load.lazyTextures)
+				load.model->CreateTextures(&streamer);
+		}
+
+		// Retire the entry once the model can be drawn (or, with lazy textures, once its meshes are up)
+		// モデルが描画できるようになったら（遅延テクスチャの場合はメッシュが転送されたら）エントリを外す
+		if (load.uploaded && (load.lazyTextures || load.model->IsResident()))
+		{
+			loadCounts[load.key]++;
+			totalLoads++;
+
+			std::cout << "Streamed " << load.key << (load.cooked ? " from card pack" : "") << ": "
+				<< load.decodeTime.count() << " ms decode, " << (load.lazyTextures ? "meshes uploaded" : "resident")
+				<< " after " << Milliseconds(Clock::now() - load.requested).count() << " ms" << std::endl;
+
+			it = streaming.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	residency.Update();
+	streamer.Update();
+}
+
+// Maps a cooked card pack so later loads can skip the glTF files
+// 以降の読み込みでglTFファイルを省略できるよう、調理済みカードパックをマッピングする
+bool ModelCache::Mount(const char* packFile)
+{
+	try
+	{
+		pack.Open(packFile);
+	}
+	catch (const std::exception& error)
+	{
+		std::cout << "Card pack " << packFile << " ignored: " << error.what() << std::endl;
+		pack = CardPack();
+		return false;
+	}
+	catch (...)
+	{
+		// A missing pack is normal before cardcook has been run
+		// cardcookを実行する前はパックが無いのが普通
+		pack = CardPack();
+		return false;
+	}
+
+	std::cout << "Mounted card pack " << packFile << std::endl;
+	return true;
+}
+
+// Returns how many times the given asset has been decoded
+// 指定されたアセットがデコードされた回数を返す
+unsigned int ModelCache::GetLoadCount(const char* file) const
+{
+	auto found = loadCounts.find(canonicalPath(file));
+	return found != loadCounts.end() ? found->second : 0;
+}
+
+// Prints load counters for every asset to the console
+// 全アセットの読み込みカウンタをコンソールに出力する
+void ModelCache::PrintStats() const
+{
+	std::cout << "ModelCache: " << totalLoads << " loads, " << cacheHits << " cache hits" << std::endl;
+
+	for (auto& entry : loadCounts)
+		std::cout << "  " << entry.first << " : " << entry.second << std::endl;
+
+	std::cout << "GeometryCache: " << geometryCache.GetUploadCount() << " uploads, "
+		<< geometryCache.GetSharedCount() << " shared" << std::endl;
+
+	// GPU memory of every texture of the live models
+	// 生存中のモデルの全テクスチャのGPUメモリ量
+	std::cout << "Textures:" << std::endl;
+	for (auto& entry : models)
+	{
+		std::shared_ptr<Model> model = entry.second.lock();
+		if (!model)
+			continue;
+
+		for (const Model::TextureSource& source : model->GetTextureSources())
+			std::cout << "  " << entry.first << " " << source.type << " " << source.image.width << "x" << source.image.height
+				<< " " << texture_format_name(source.image.internalFormat) << ": " << source.image.GetBytes() / 1024 << " KB" << std::endl;
+	}
+
+	std::cout << "TextureResidency: " << residency.GetResidentBytes() / 1024 << " / " << residency.GetBudget() / 1024
+		<< " KB resident, " << residency.GetUploadCount() << " uploads, " << residency.GetEvictionCount() << " evictions" << std::endl;
+}
+
+// Builds the cache key so different spellings of the same file share one entry
+// 同じファイルの異なる表記が1つのエントリを共有するようにキャッシュキーを作成する
+std::string ModelCache::canonicalPath(const char* file)
+{
+	std::error_code error;
+	std::filesystem::path path = std::filesystem::weakly_canonical(file, error);
+
+	// Fall back to the path as given if it cannot be resolved
+	// 解決できない場合は与えられたパスをそのまま使う
+	if (error)
+		return std::string(file);
+
+	return path.generic_string();
+}
+
+// Prints one line per subsystem, then the total
+// サブシステムごとに1行出力し、最後に合計を出力する
+void ModelCache::PrintMemory() const
+{
+	auto print = [](const char* name, const MemoryUsage& usage)
+	{
+		std::cout << "  " << name << ": " << usage.cpuBytes / 1024 << " KB CPU, " << usage.bufferBytes / 1024
+			<< " KB buffers, " << usage.textureBytes / 1024 << " KB textures" << std::endl;
+	};
+
+	MemoryUsage modelUsage;
+	for (auto& entry : models)
+	{
+		std::shared_ptr<Model> model = entry.second.lock();
+		if (model)
+			modelUsage += model->GetMemoryUsage();
+	}
+
+	MemoryUsage total;
+	std::cout << "Memory:" << std::endl;
+	print("Models", modelUsage);
+	total += modelUsage;
+	print("GeometryCache", geometryCache.GetMemoryUsage());
+	total += geometryCache.GetMemoryUsage();
+	print("TextureResidency", residency.GetMemoryUsage());
+	total += residency.GetMemoryUsage();
+	print("TextureStreamer", streamer.GetMemoryUsage());
+	total += streamer.GetMemoryUsage();
+	print("Total", total);
+
+	// Live GL objects, which should stay flat over a long session
+	// 生存中のGLオブジェクト（長時間のセッションでも増え続けてはならない）
+	std::cout << "  GL objects: " << GLBuffer::GetLiveCount() << " buffers, " << GLVertexArray::GetLiveCount() << " vertex arrays, "
+		<< GLTexture::GetLiveCount() << " textures, " << GLProgram::GetLiveCount() << " programs" << std::endl;
+
+	// The pack is mapped rather than allocated, so it is listed apart from the total
+	// パックは確保ではなくマッピングのため、合計とは別に表示する
+	if (pack.IsOpen())
+		std::cout << "  CardPack: " << pack.GetMappedBytes() / 1024 << " KB mapped" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#ifndef MODEL_CACHE_CLASS_H
+#define MODEL_CACHE_CLASS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <unordered_map>
+#include "Model.h"
+#include "GeometryCache.h"
+#include "CardPack.h"
+#include "ThreadPool.h"
+#include "TextureStreamer.h"
+#include "TextureResidency.h"
+
+// ModelCache class that shares one GPU-resident Model per asset path
+// アセットパスごとに1つのGPU常駐Modelを共有するModelCacheクラス
+class ModelCache
+{
+public:
+
+	// Returns a shared handle to the model, loading it only on first request
+	// モデルへの共有ハンドルを返す（初回要求時のみ読み込む）
+	// retention is added to the cache-wide SetCpuRetention flags
+	// retentionはキャッシュ全体のSetCpuRetentionのフラグに加えられる
+	std::shared_ptr<Model> Load(const char* file, CpuRetention retention = RETAIN_NOTHING);
+
+	// Loads several models at once: files are parsed and decoded in parallel on the worker pool,
+	// then uploaded on the calling (GL context) thread. Returns one model per file, in order.
+	// 複数のモデルを一度に読み込む：ファイルはワーカープールで並列に解析・デコードされ、
+	// その後呼び出し元（GLコンテキスト）のスレッドで転送される。ファイルごとに1つのモデルを順に返す
+	std::vector<std::shared_ptr<Model>> LoadAll(const char* const files[], unsigned int count, CpuRetention retention = RETAIN_NOTHING);
+
+	// Returns a handle to the model without waiting for it: the model is empty until it has been decoded
+	// and uploaded by later calls to Update, so draw a placeholder while IsResident() is false.
+	// With lazyTextures only the meshes are uploaded; request the textures through GetTextureResidency().
+	// 待たずにモデルへのハンドルを返す：以降のUpdate呼び出しでデコード・転送されるまでモデルは空のため、
+	// IsResident()がfalseの間はプレースホルダーを描画する
+	// lazyTexturesの場合はメッシュのみ転送する（テクスチャはGetTextureResidency()で要求する）
+	std::shared_ptr<Model> Stream(const char* file, bool lazyTextures = false);
+
+	// Uploads streamed models whose decode has finished and feeds the texture streamer (call once per frame)
+	// デコードが終わったストリーミング中のモデルを転送し、テクスチャストリーマーを進める（毎フレーム1回呼ぶ）
+	void Update();
+
+	// Returns true while streamed models are still loading
+	// ストリーミング中のモデルがまだ読み込み中であればtrueを返す
+	inline bool IsStreaming() const { return !streaming.empty(); }
+
+	// Maps a card pack cooked by cardcook; models found in it are loaded from the pack
+	// Returns false (and keeps loading glTF files) if the pack does not exist or cannot be read
+	// cardcookで調理されたカードパックをマッピングする（パック内のモデルはパックから読み込まれる）
+	// パックが存在しないか読み込めない場合はfalseを返す（glTFファイルの読み込みを続ける）
+	bool Mount(const char* packFile);
+
+	// Sets the CPU copies every model loaded from now on keeps after upload (lazily textured models always keep their pixels)
+	// 今後読み込むすべてのモデルが転送後に保持するCPU側コピーを設定する（遅延テクスチャのモデルは常にピクセルを保持する）
+	inline void SetCpuRetention(CpuRetention flags) { retention = flags; }
+
+	// Returns how many times the given asset has been decoded
+	// 指定されたアセットがデコードされた回数を返す
+	unsigned int GetLoadCount(const char* file) const;
+
+	// Returns the cache that shares identical geometry between models
+	// モデル間で同一ジオメトリを共有するキャッシュを返す
+	inline GeometryCache& GetGeometryCache() { return geometryCache; }
+
+	// Returns the residency manager that creates and evicts lazily loaded textures
+	// 遅延読み込みのテクスチャを作成・退避する常駐管理を返す
+	inline TextureResidency& GetTextureResidency() { return residency; }
+
+	// Returns the total number of model decodes
+	// モデルのデコード総数を返す
+	inline unsigned int GetTotalLoads() const { return totalLoads; }
+
+	// Returns the number of requests served from the cache
+	// キャッシュから返された要求の数を返す
+	inline unsigned int GetCacheHits() const { return cacheHits; }
+
+	// Prints load counters for every asset to the console
+	// 全アセットの読み込みカウンタをコンソールに出力する
+	void PrintStats() const;
+
+	// Prints the CPU, GPU buffer and texture memory of every subsystem to the console
+	// 各サブシステムのCPU・GPUバッファ・テクスチャのメモリ量をコンソールに出力する
+	void PrintMemory() const;
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+	// Model requested through Stream that is not resident yet
+	// Streamで要求され、まだ常駐していないモデル
+	struct Streaming
+	{
+		std::string key;
+		std::shared_ptr<Model> model;
+		const CardPackModel* cooked;
+		std::future<ModelData> data;
+		Milliseconds decodeTime;
+		Clock::time_point requested;
+		bool lazyTextures = false;
+		bool uploaded = false;
+	};
+
+	// Converts a model path into the canonical key used by the cache
+	// モデルパスをキャッシュで使う正規化キーに変換する
+	static std::string canonicalPath(const char* file);
+
+	// Loaded models keyed by canonical path (expired once no card holds them)
+	// 正規化パスをキーとした読み込み済みモデル（どのカードも保持しなくなると失効する）
+	std::unordered_map<std::string, std::weak_ptr<Model>> models;
+
+	// Geometry shared between every model loaded through this cache
+	// このキャッシュで読み込まれたすべてのモデル間で共有されるジオメトリ
+	GeometryCache geometryCache;
+
+	// Cooked card pack (not open unless Mount succeeded)
+	// 調理済みカードパック（Mountが成功しない限り開かれていない）
+	CardPack pack;
+
+	// Spreads texture uploads of streamed models over several frames
+	// ストリーミング中のモデルのテクスチャ転送を複数フレームに分散する
+	TextureStreamer streamer;
+
+	// Keeps lazily loaded textures within a GPU memory budget
+	// 遅延読み込みのテクスチャをGPUメモリの予算内に保つ
+	TextureResidency residency{ streamer };
+
+	// Streamed models that are still loading (a list, since workers write decodeTime in place)
+	// 読み込み中のストリーミングモデル（ワーカーがdecodeTimeを直接書き込むためlistを使う）
+	std::list<Streaming> streaming;
+
+	// Worker threads for the CPU phase of loading (file read, JSON parse, vertex assembly, image decode)
+	// Declared after streaming so the workers finish before the entries they write into are destroyed
+	// 読み込みのCPUフェーズ（ファイル読み込み・JSON解析・頂点組み立て・画像デコード）用のワーカースレッド
+	// 書き込み先のエントリが破棄される前にワーカーが終わるよう、streamingより後に宣言する
+	ThreadPool pool;
+
+	// CPU copies models keep after upload
+	// モデルが転送後に保持するCPU側コピー
+	CpuRetention retention = RETAIN_NOTHING;
+
+	// Number of decodes per canonical path
+	// 正規化パスごとのデコード回数
+	std::unordered_map<std::string, unsigned int> loadCounts;
+
+	// Total number of model decodes
+	// モデルのデコード総数
+	unsigned int totalLoads = 0;
+
+	// Number of requests served from the cache
+	// キャッシュから返された要求の数
+	unsigned int cacheHits = 0;
+};
+
+#endif
\ No newline at end of file
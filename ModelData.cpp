@@ -0,0 +1,518 @@
+#include "ModelData.h"
+
+#include <stdexcept>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include "GeometryCache.h"
+
+ModelData::ModelData(const char* file)
+{
+	// Store the file path for later use (e.g., loading textures and buffers)
+	// 後でテクスチャやバッファを読み込むためにファイルパスを保存する
+	ModelData::file = file;
+
+	// Map the whole model file with a single open
+	// 1回のオープンでモデルファイル全体をマッピングする
+	source.Open(file);
+
+	// Binary buffer embedded in the file (.glb only)
+	// ファイルに埋め込まれたバイナリバッファ（.glbのみ）
+	ByteRange embedded;
+
+	if (GLTFDocument::IsGLB(source.Data(), source.Size()))
+	{
+		// Parse the JSON chunk in place and keep the BIN chunk for the buffers
+		// JSONチャンクをその場で解析し、BINチャンクをバッファ用に保持する
+		GLBChunks chunks = GLTFDocument::ReadGLB(source.Data(), source.Size());
+		document = GLTFDocument(chunks.json, chunks.jsonSize);
+		embedded.data = chunks.bin;
+		embedded.size = chunks.binSize;
+	}
+	else
+	{
+		// Parse the glTF file once into typed structs
+		// glTFファイルを一度だけ解析し、型付き構造体に変換する
+		document = GLTFDocument((const char*)source.Data(), source.Size());
+	}
+
+	// Resolve the binary buffers referenced by the glTF file
+	// glTFファイルが参照しているバイナリバッファを解決する
+	mapBuffers(embedded);
+
+	// Decode the images shared by every mesh of the model
+	// モデルのすべてのメッシュで共有される画像をデコードする
+	getImages();
+
+	// Begin traversing the scene graph starting from the root node (index 0)
+	// ルートノード（インデックス0）からシーングラフの探索を開始する
+	traverseNode(0);
+
+	// Everything has been decoded, so the mappings and document are no longer needed
+	// すべてデコード済みのため、マッピングとドキュメントはもう不要
+	buffers.clear();
+	bufferFiles.clear();
+	source.Close();
+	document = GLTFDocument();
+}
+
+void ModelData::loadMesh(unsigned int indMesh, MeshData& mesh)
+{
+	// Get the first primitive of the mesh, which holds all accessor indices
+	// すべてのアクセサインデックスを持つ、メッシュの最初のプリミティブを取得する
+	const GLTFPrimitive& primitive = document.meshes[indMesh].primitives[0];
+
+	// The renderer needs positions, normals, texture coordinates and indices
+	// レンダラーには位置・法線・テクスチャ座標・インデックスが必要
+	if (primitive.position < 0 || primitive.normal < 0 || primitive.texCoord0 < 0 || primitive.indices < 0)
+		throw std::invalid_argument("Mesh primitive is missing POSITION, NORMAL, TEXCOORD_0 or indices");
+
+	// Get the accessors for positions, normals, texture coordinates (UVs) and indices
+	// 位置・法線・テクスチャ座標（UV）・インデックスのアクセサを取得する
+	const GLTFAccessor& posAccessor = document.accessors[primitive.position];
+	const GLTFAccessor& normalAccessor = document.accessors[primitive.normal];
+	const GLTFAccessor& texAccessor = document.accessors[primitive.texCoord0];
+	const GLTFAccessor& indAccessor = document.accessors[primitive.indices];
+
+	// Hash the contents of every accessor that feeds the GPU buffers
+	// GPUバッファに使われるすべてのアクセサの内容をハッシュする
+	mesh.hash = GeometryCache::HashBytes(nullptr, 0);
+	mesh.hash = hashAccessor(posAccessor, mesh.hash);
+	mesh.hash = hashAccessor(normalAccessor, mesh.hash);
+	mesh.hash = hashAccessor(texAccessor, mesh.hash);
+	mesh.hash = hashAccessor(indAccessor, mesh.hash);
+
+	// View positions, normals and texture coordinates directly in the mapped buffer
+	// 位置・法線・テクスチャ座標をマッピングされたバッファ上で直接参照する
+	AccessorView<glm::vec3> positions = getAccessor<glm::vec3>(posAccessor);
+	AccessorView<glm::vec3> normals = getAccessor<glm::vec3>(normalAccessor);
+	AccessorView<glm::vec2> texUVs = getAccessor<glm::vec2>(texAccessor);
+
+	// Combine positions, normals, and UVs into Vertex structures
+	// 位置・法線・UVをVertex構造体にまとめる
+	mesh.vertices = assembleVertices(positions, normals, texUVs);
+
+	// Retrieve index data from buffer
+	// バッファからインデックスデータを取得する
+	getIndices(indAccessor, mesh);
+
+	// Reorder the mesh for the vertex cache and vertex fetch (the hash above still names the source data,
+	// and the optimizer is deterministic, so meshes with equal hashes still get equal geometry)
+	// 頂点キャッシュと頂点フェッチのためにメッシュを並べ替える（上のハッシュは元データを表したままだが、
+	// オプティマイザは決定的なため、ハッシュの等しいメッシュは等しいジオメトリになる）
+	optimizeMesh(mesh);
+
+	// The POSITION accessor must store the exact bounds of the positions, so take the bounding box from it
+	// (the sphere keeps the farthest vertex, moved out by however far the center shifts)
+	// POSITIONアクセサは位置の正確な範囲を格納しているはずなので、バウンディングボックスはそこから取る
+	// （球は最も遠い頂点を保ち、中心がずれた分だけ広げる）
+	if (posAccessor.min.size() >= 3 && posAccessor.max.size() >= 3)
+	{
+		glm::vec3 boundsMin = glm::make_vec3(posAccessor.min.data());
+		glm::vec3 boundsMax = glm::make_vec3(posAccessor.max.data());
+		glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+		mesh.lods.radius += glm::length(center - mesh.lods.center);
+		mesh.lods.center = center;
+		mesh.lods.extents = (boundsMax - boundsMin) * 0.5f;
+	}
+}
+
+void ModelData::traverseNode(unsigned int nextNode, glm::mat4 matrix)
+{
+	// Get the current node from the document's scene graph (by reference, no copy)
+	// ドキュメントのシーングラフから現在のノードを取得する（参照で取得しコピーしない）
+	const GLTFNode& node = document.nodes[nextNode];
+
+	// Initialize separate TRS matrices
+	// 平行移動・回転・拡大縮小用の行列を初期化する
+	glm::mat4 trans = glm::mat4(1.0f);
+	glm::mat4 rot = glm::mat4(1.0f);
+	glm::mat4 sca = glm::mat4(1.0f);
+
+	// Convert translation vector into matrix
+	// translationベクトルを行列に変換する
+	trans = glm::translate(trans, node.translation);
+
+	// Convert quaternion into rotation matrix
+	// クォータニオンを回転行列に変換する
+	rot = glm::mat4_cast(node.rotation);
+
+	// Convert scale vector into scale matrix
+	// scaleベクトルを拡大縮小行列に変換する
+	sca = glm::scale(sca, node.scale);
+
+	// Combine parent matrix with current node transformations
+	// 親ノードの行列と現在のノードの変換を合成する
+	glm::mat4 matNextNode = matrix * node.matrix * trans * rot * sca;
+
+	// If this node contains a mesh, store its transform and decode it
+	// このノードにメッシュがある場合は変換情報を保存し、デコードする
+	if (node.mesh >= 0)
+	{
+		MeshData mesh;
+		mesh.matrix = matNextNode;
+
+		loadMesh(node.mesh, mesh);
+		meshes.push_back(std::move(mesh));
+	}
+
+	// Recursively traverse the children of this node
+	// このノードの子ノードを再帰的に探索する
+	for (int child : node.children)
+		traverseNode(child, matNextNode);
+}
+
+// Resolve every buffer referenced by the glTF file to bytes in memory
+// glTFファイルで参照されているすべてのバッファをメモリ上のバイト列に解決する
+void ModelData::mapBuffers(ByteRange embedded)
+{
+	// Convert the model file path to a string
+	// モデルのファイルパスを文字列に変換する
+	std::string fileStr = file;
+
+	// Extract the directory path from the full file path
+	// フルパスからディレクトリ部分を取得する
+	std::string fileDirectory = fileStr.substr(0, fileStr.find_last_of('/') + 1);
+
+	// Map each external buffer file once; reserve so the mappings never move
+	// 各外部バッファファイルを一度だけマッピングする（マッピングが移動しないよう予約する）
+	bufferFiles.reserve(document.buffers.size());
+
+	for (unsigned int i = 0; i < document.buffers.size(); i++)
+	{
+		const GLTFBuffer& buffer = document.buffers[i];
+		ByteRange range;
+
+		if (buffer.uri.empty())
+		{
+			// A buffer without a URI is the BIN chunk of a .glb (only the first buffer may be)
+			// URIの無いバッファは.glbのBINチャンク（最初のバッファのみ許される）
+			if (i != 0 || embedded.data == nullptr)
+				throw std::invalid_argument("Buffer has no URI and no embedded BIN chunk");
+			range = embedded;
+		}
+		else if (buffer.uri.rfind("data:", 0) == 0)
+		{
+			throw std::invalid_argument("Base64 data URI buffers are not supported");
+		}
+		else
+		{
+			// Map the buffer file instead of copying it into memory
+			// バッファファイルをメモリにコピーせずマッピングする
+			bufferFiles.emplace_back((fileDirectory + buffer.uri).c_str());
+			range.data = bufferFiles.back().Data();
+			range.size = bufferFiles.back().Size();
+		}
+
+		buffers.push_back(range);
+	}
+}
+
+// Returns the bytes covered by a buffer view, checked against its buffer
+// バッファビューが指すバイト列を返す（バッファの範囲で確認する）
+ByteRange ModelData::getBufferView(int bufferView)
+{
+	if (bufferView < 0 || bufferView >= (int)document.bufferViews.size())
+		throw std::invalid_argument("Invalid bufferView index");
+
+	const GLTFBufferView& view = document.bufferViews[bufferView];
+	if (view.buffer < 0 || view.buffer >= (int)buffers.size())
+		throw std::invalid_argument("Invalid buffer index");
+
+	const ByteRange& buffer = buffers[view.buffer];
+	if ((size_t)view.byteOffset + view.byteLength > buffer.size)
+		throw std::out_of_range("Buffer view reaches past the end of its buffer");
+
+	ByteRange range;
+	range.data = buffer.data + view.byteOffset;
+	range.size = view.byteLength;
+	return range;
+}
+
+// Hash the layout and raw bytes of an accessor so identical data gives the same key
+// 同一データが同じキーになるよう、アクセサのレイアウトと生バイトをハッシュする
+uint64_t ModelData::hashAccessor(const GLTFAccessor& accessor, uint64_t hash)
+{
+	// Get the bytes of the buffer view the accessor reads from
+	// アクセサが読み取るバッファビューのバイト列を取得する
+	ByteRange view = getBufferView(accessor.bufferView);
+
+	// Elements are read with the same stride as getAccessor (0 means tightly packed), so interleaved
+	// attributes hash their own bytes and not their neighbors'
+	// 要素はgetAccessorと同じストライドで読む（0は詰めて配置されていることを意味する）ため、
+	// インターリーブされた属性は隣の属性ではなく自身のバイトをハッシュする
+	unsigned int size = accessor.ElementSize();
+	const GLTFBufferView& bufferView = document.bufferViews[accessor.bufferView];
+	unsigned int stride = bufferView.byteStride ? bufferView.byteStride : size;
+
+	// Mix the layout into the hash so equal bytes with a different meaning differ
+	// 意味の異なる同一バイト列を区別するため、レイアウトもハッシュに混ぜる
+	unsigned int layout[] = { accessor.count, accessor.componentType, size, stride };
+	hash = GeometryCache::HashBytes(layout, sizeof(layout), hash);
+
+	if (accessor.count > 0 && accessor.byteOffset + (size_t)(accessor.count - 1) * stride + size > view.size)
+		throw std::out_of_range("Accessor reads past the end of its buffer view");
+
+	// Hash the raw bytes of each element the accessor refers to
+	// アクセサが参照する各要素の生バイトをハッシュする
+	const unsigned char* element = view.data + accessor.byteOffset;
+	for (unsigned int i = 0; i < accessor.count; i++, element += stride)
+		hash = GeometryCache::HashBytes(element, size, hash);
+
+	return hash;
+}
+
+// Build a typed view over the accessor's elements inside the mapped buffer
+// マッピングされたバッファ内のアクセサ要素に対する型付きビューを作成する
+template <typename T>
+AccessorView<T> ModelData::getAccessor(const GLTFAccessor& accessor)
+{
+	// Get the bytes of the buffer view the accessor reads from
+	// アクセサが読み取るバッファビューのバイト列を取得する
+	ByteRange view = getBufferView(accessor.bufferView);
+
+	// The accessor layout must match the type being read
+	// アクセサのレイアウトは読み取る型と一致しなければならない
+	if (accessor.ElementSize() != sizeof(T))
+		throw std::invalid_argument("Accessor element size does not match the requested type");
+
+	// Retrieve the corresponding bufferView
+	// 対応するbufferViewを取得する
+	const GLTFBufferView& bufferView = document.bufferViews[accessor.bufferView];
+
+	// Get the element stride (0 means tightly packed)
+	// 要素のストライドを取得する（0は詰めて配置されていることを意味する）
+	size_t byteStride = bufferView.byteStride ? bufferView.byteStride : sizeof(T);
+
+	// Get the number of elements defined by the accessor
+	// アクセサで定義されている要素数を取得する
+	unsigned int count = accessor.count;
+
+	// Make sure every element lies inside the buffer view
+	// すべての要素がバッファビュー内にあることを確認する
+	if (count > 0 && accessor.byteOffset + (size_t)(count - 1) * byteStride + sizeof(T) > view.size)
+		throw std::out_of_range("Accessor reads past the end of its buffer view");
+
+	return AccessorView<T>(view.data + accessor.byteOffset, count, byteStride);
+}
+
+// Extract index data from the buffer using accessor information
+// アクセサ情報を使用してバッファからインデックスデータを取得する
+void ModelData::getIndices(const GLTFAccessor& accessor, MeshData& mesh)
+{
+	// Get component type (data type of indices)
+	// インデックスのデータ型（componentType）を取得する
+	unsigned int componentType = accessor.componentType;
+
+	// If indices are unsigned int (4 bytes per index), narrow them to 16 bits when every vertex can still be reached
+	// インデックスがunsigned int（4バイト）の場合、すべての頂点を参照できるなら16ビットに縮める
+	if (componentType == 5125)
+	{
+		AccessorView<unsigned int> view = getAccessor<unsigned int>(accessor);
+
+		// Check the full 32-bit values before narrowing, or an index past 65535 would wrap onto a valid vertex
+		// 縮める前に32ビットの値のまま確認する（そうしないと65535を超えるインデックスが有効な頂点に回り込む）
+		for (size_t i = 0; i < view.Size(); i++)
+			if (view[i] >= mesh.vertices.size())
+				throw std::out_of_range("Index refers to a vertex past the end of the mesh");
+
+		if (mesh.vertices.size() <= 65536)
+		{
+			mesh.indexType = GL_UNSIGNED_SHORT;
+			mesh.shortIndices.resize(view.Size());
+			for (size_t i = 0; i < view.Size(); i++)
+				mesh.shortIndices[i] = (GLushort)view[i];
+		}
+		else
+		{
+			mesh.indexType = GL_UNSIGNED_INT;
+			mesh.indices.resize(view.Size());
+			for (size_t i = 0; i < view.Size(); i++)
+				mesh.indices[i] = (GLuint)view[i];
+		}
+	}
+	// If indices are unsigned short (2 bytes per index), or signed short, which is never negative as an index
+	// インデックスがunsigned short（2バイト）、またはインデックスとして負にならないsigned shortの場合
+	else if (componentType == 5123 || componentType == 5122)
+	{
+		AccessorView<unsigned short> view = getAccessor<unsigned short>(accessor);
+		mesh.indexType = GL_UNSIGNED_SHORT;
+		mesh.shortIndices.resize(view.Size());
+		for (size_t i = 0; i < view.Size(); i++)
+			mesh.shortIndices[i] = view[i];
+	}
+	// If indices are unsigned bytes, widen them to 16 bits (8-bit indices are slow on most GPUs)
+	// インデックスがunsigned byteの場合、16ビットに広げる（8ビットのインデックスは多くのGPUで遅い）
+	else if (componentType == 5121)
+	{
+		AccessorView<unsigned char> view = getAccessor<unsigned char>(accessor);
+		mesh.indexType = GL_UNSIGNED_SHORT;
+		mesh.shortIndices.resize(view.Size());
+		for (size_t i = 0; i < view.Size(); i++)
+			mesh.shortIndices[i] = view[i];
+	}
+	else
+		throw std::invalid_argument("Unsupported index component type");
+
+	// Every index must refer to an existing vertex
+	// すべてのインデックスが存在する頂点を指していなければならない
+	for (GLushort index : mesh.shortIndices)
+		if (index >= mesh.vertices.size())
+			throw std::out_of_range("Index refers to a vertex past the end of the mesh");
+	for (GLuint index : mesh.indices)
+		if (index >= mesh.vertices.size())
+			throw std::out_of_range("Index refers to a vertex past the end of the mesh");
+}
+
+
+// Decode the images defined in the glTF file
+// glTFファイルで定義されている画像をデコードする
+void ModelData::getImages()
+{
+	// Convert model file path to string
+	// モデルのファイルパスを文字列に変換する
+	std::string fileStr = file;
+
+	// Extract directory path from model file
+	// モデルファイルからディレクトリパスを取得する
+	std::string fileDirectory = fileStr.substr(0, fileStr.find_last_of('/') + 1);
+
+	// Loop through all images defined in glTF
+	// glTF内で定義されているすべての画像をループする
+	for (unsigned int i = 0; i < document.images.size(); i++)
+	{
+		const GLTFImage& image = document.images[i];
+
+		// Find which material slot uses this image
+		// この画像を使用するマテリアルスロットを探す
+		bool isBaseColor = false;
+		bool isMetallicRoughness = false;
+		for (const GLTFMaterial& material : document.materials)
+		{
+			if (material.baseColorTexture >= 0 && document.textures[material.baseColorTexture].source == (int)i)
+				isBaseColor = true;
+			if (material.metallicRoughnessTexture >= 0 && document.textures[material.metallicRoughnessTexture].source == (int)i)
+				isMetallicRoughness = true;
+		}
+
+		// Fall back to the file name when no material references the image
+		// どのマテリアルからも参照されない場合はファイル名で判断する
+		if (!isBaseColor && !isMetallicRoughness)
+		{
+			isBaseColor = image.uri.find("baseColor") != std::string::npos;
+			isMetallicRoughness = image.uri.find("metallicRoughness") != std::string::npos;
+		}
+
+		// If texture is a base color map, treat it as diffuse
+		// baseColorテクスチャの場合、diffuseとして扱う
+		if (isBaseColor)
+			decodeImage(image, fileDirectory, "diffuse");
+
+		// If texture is metallic-roughness map, treat it as specular
+		// metallicRoughnessテクスチャの場合、specularとして扱う
+		if (isMetallicRoughness)
+			decodeImage(image, fileDirectory, "specular");
+	}
+}
+
+// Decode an image, either from its file or straight from the mapped buffer
+// 画像をデコードする（ファイルから、またはマッピングされたバッファから直接）
+void ModelData::decodeImage(const GLTFImage& image, const std::string& fileDirectory, const char* texType)
+{
+	ImageData decoded;
+	decoded.type = texType;
+
+	// The image comes out flipped vertically for OpenGL: the program sets stb_image's global flip flag once at
+	// startup, since setting it here would race with other worker threads decoding at the same time
+	// 画像はOpenGL向けに上下反転されて出てくる（stb_imageのグローバルな反転フラグはプログラムが起動時に一度だけ
+	// 設定する。ここで設定すると、同時にデコードしている他のワーカースレッドと競合するため）
+
+	if (image.bufferView >= 0)
+	{
+		// Decode the encoded PNG/JPEG bytes without writing them to disk
+		// エンコードされたPNG/JPEGのバイト列をディスクに書き出さずにデコードする
+		ByteRange bytes = getBufferView(image.bufferView);
+		decoded.pixels.reset(stbi_load_from_memory(bytes.data, (int)bytes.size, &decoded.width, &decoded.height, &decoded.channels, 0));
+	}
+	else
+	{
+		if (image.uri.rfind("data:", 0) == 0)
+			throw std::invalid_argument("Base64 data URI images are not supported");
+
+		decoded.pixels.reset(stbi_load((fileDirectory + image.uri).c_str(), &decoded.width, &decoded.height, &decoded.channels, 0));
+	}
+
+	// Stop here if the image could not be decoded
+	// 画像をデコードできなかった場合はここで中断する
+	if (!decoded.pixels)
+		throw std::invalid_argument("Texture image could not be decoded");
+
+	images.push_back(std::move(decoded));
+}
+
+// Interleaves position, normal, and texture coordinate data into Vertex objects
+// 位置・法線・テクスチャ座標のデータをVertexオブジェクトにインターリーブする
+std::vector<Vertex> ModelData::assembleVertices
+(
+	const AccessorView<glm::vec3>& positions,
+	const AccessorView<glm::vec3>& normals,
+	const AccessorView<glm::vec2>& texUVs
+)
+{
+	// Every attribute must provide a value for each position
+	// すべての属性が各位置に対する値を持っていなければならない
+	if (normals.Size() < positions.Size() || texUVs.Size() < positions.Size())
+		throw std::invalid_argument("Vertex attributes have fewer elements than positions");
+
+	// Allocate the final vertex array once
+	// 最終的な頂点配列を一度だけ確保する
+	std::vector<Vertex> vertices(positions.Size());
+
+	// Write each vertex in place from the mapped buffer
+	// マッピングされたバッファから各頂点をその場で書き込む
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		// Corresponding position, normal and texture UV
+		// 対応する位置・法線・テクスチャUV
+		vertices[i].position = positions[i];
+		vertices[i].normal = normals[i];
+		vertices[i].texUV = texUVs[i];
+	}
+
+	// Return the completed vertex list
+	// 完成した頂点リストを返す
+	return vertices;
+}
+
+void ModelData::optimizeMesh(MeshData& mesh)
+{
+	// The optimizer works on 32-bit indices; this copy lives only while the mesh decodes
+	// オプティマイザは32ビットのインデックスを扱う（このコピーはメッシュのデコード中のみ存在する）
+	std::vector<uint32_t> work;
+	if (mesh.indexType == GL_UNSIGNED_SHORT)
+		work.assign(mesh.shortIndices.begin(), mesh.shortIndices.end());
+	else
+		work.assign(mesh.indices.begin(), mesh.indices.end());
+
+	mesh.optimization = optimize_mesh(mesh.vertices, work);
+
+	// The levels of detail are appended to the same indices (and the impostor to the vertices)
+	// 詳細度レベルは同じインデックスに（インポスターは頂点に）追加される
+	mesh.lods = build_mesh_lods(mesh.vertices, work);
+
+	// Merging vertices may have brought the mesh under the 16-bit limit
+	// 頂点の統合によってメッシュが16ビットの上限を下回った場合もある
+	mesh.shortIndices.clear();
+	mesh.indices.clear();
+	if (mesh.vertices.size() <= 65536)
+	{
+		mesh.indexType = GL_UNSIGNED_SHORT;
+		mesh.shortIndices.resize(work.size());
+		for (size_t i = 0; i < work.size(); i++)
+			mesh.shortIndices[i] = (GLushort)work[i];
+	}
+	else
+	{
+		mesh.indexType = GL_UNSIGNED_INT;
+		mesh.indices = std::move(work);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#ifndef MODEL_DATA_CLASS_H
+#define MODEL_DATA_CLASS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <stb/stb_image.h>
+
+#include "VBO.h"
+#include "MeshOptimizer.h"
+#include "MappedFile.h"
+#include "AccessorView.h"
+#include "GLTFDocument.h"
+
+// Vertex and index data of one mesh together with its node transform
+// ノードの変換情報と合わせた、1つのメッシュの頂点・インデックスデータ
+struct MeshData
+{
+	// Interleaved vertices
+	// インターリーブされた頂点
+	std::vector<Vertex> vertices;
+
+	// Triangle indices of every level of detail in the narrowest width that reaches every vertex: shortIndices
+	// when indexType is GL_UNSIGNED_SHORT, indices when it is GL_UNSIGNED_INT (the other vector stays empty)
+	// すべての頂点を参照できる最小幅の、全詳細度レベルの三角形インデックス（indexTypeがGL_UNSIGNED_SHORTなら
+	// shortIndices、GL_UNSIGNED_INTならindicesを使い、もう一方は空のまま）
+	std::vector<GLushort> shortIndices;
+	std::vector<GLuint> indices;
+	GLenum indexType = GL_UNSIGNED_INT;
+
+	// Returns the number of indices and a pointer to them in indexType
+	// インデックス数と、indexTypeのインデックスへのポインタを返す
+	inline GLsizei GetIndexCount() const { return (GLsizei)(indexType == GL_UNSIGNED_SHORT ? shortIndices.size() : indices.size()); }
+	inline const void* GetIndexData() const { return indexType == GL_UNSIGNED_SHORT ? (const void*)shortIndices.data() : (const void*)indices.data(); }
+
+	// What the optimizer did to the mesh while it was decoded (cache statistics before and after)
+	// デコード時にオプティマイザがメッシュに行ったこと（前後のキャッシュ統計）
+	MeshOptimizeReport optimization;
+
+	// Levels of detail, as ranges of the indices above (level 0 is the full mesh)
+	// 上記のインデックス内の範囲としての詳細度レベル（レベル0は完全なメッシュ）
+	MeshLodChain lods;
+
+	// Content hash of the source accessors, used to share GPU geometry
+	// GPUジオメトリの共有に使う、元のアクセサの内容ハッシュ
+	uint64_t hash = 0;
+
+	// Node transform the mesh is drawn with
+	// メッシュの描画に使うノードの変換
+	glm::mat4 matrix = glm::mat4(1.0f);
+};
+
+// Decoded pixels of one texture image
+// 1枚のテクスチャ画像のデコード済みピクセル
+struct ImageData
+{
+	// Texture type used by the shader ("diffuse" or "specular")
+	// シェーダーで使うテクスチャの種類（"diffuse"または"specular"）
+	const char* type = "diffuse";
+
+	// Size and number of color channels
+	// サイズとカラーチャンネル数
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+
+	// Pixels flipped for OpenGL, freed by stb_image
+	// OpenGL向けに上下反転されたピクセル（stb_imageで解放される）
+	std::unique_ptr<unsigned char, void (*)(void*)> pixels{ nullptr, stbi_image_free };
+};
+
+// ModelData class that decodes a glTF/GLB file into plain CPU data without touching OpenGL
+// OpenGLに触れずにglTF/GLBファイルを単純なCPUデータにデコードするModelDataクラス
+class ModelData
+{
+public:
+
+	// Meshes in scene graph order, each with its transform
+	// シーングラフ順のメッシュ（それぞれ変換情報を持つ）
+	std::vector<MeshData> meshes;
+
+	// Texture images used by every mesh of the model
+	// モデルのすべてのメッシュが使うテクスチャ画像
+	std::vector<ImageData> images;
+
+	// Constructor that decodes the model file
+	// モデルファイルをデコードするコンストラクタ
+	ModelData(const char* file);
+
+private:
+
+	// Path to the model file
+	// モデルファイルへのパス
+	std::string file;
+
+	// The .gltf or .glb file itself, memory-mapped while the model decodes
+	// モデルのデコード中にメモリマッピングされる.gltfまたは.glbファイル自体
+	MappedFile source;
+
+	// External buffer files, memory-mapped while the model decodes
+	// モデルのデコード中にメモリマッピングされる外部バッファファイル
+	std::vector<MappedFile> bufferFiles;
+
+	// Bytes of every glTF buffer, by buffer index (inside source or bufferFiles)
+	// バッファインデックスごとの各glTFバッファのバイト列（sourceまたはbufferFiles内）
+	std::vector<ByteRange> buffers;
+
+	// Typed structure of the glTF file, kept only while the model decodes
+	// glTFファイルの型付き構造（モデルのデコード中のみ保持する）
+	GLTFDocument document;
+
+	// Decodes a mesh from the document using its index
+	// インデックスを使ってドキュメントからメッシュをデコードする
+	void loadMesh(unsigned int indMesh, MeshData& mesh);
+
+	// Recursively traverses a node in the scene graph and applies transformations
+	// シーングラフ内のノードを再帰的に巡回し、変換を適用する
+	void traverseNode(unsigned int nextNode, glm::mat4 matrix = glm::mat4(1.0f));
+
+	// Resolves every buffer to bytes, mapping external files and using the .glb BIN chunk
+	// 外部ファイルをマッピングし、.glbのBINチャンクを使ってすべてのバッファをバイト列に解決する
+	void mapBuffers(ByteRange embedded);
+
+	// Returns the bytes covered by a buffer view
+	// バッファビューが指すバイト列を返す
+	ByteRange getBufferView(int bufferView);
+
+	// Hashes the type information and raw bytes referenced by an accessor
+	// アクセサが参照する型情報と生バイトをハッシュする
+	uint64_t hashAccessor(const GLTFAccessor& accessor, uint64_t hash);
+
+	// Returns a typed view that reads an accessor's elements straight from the mapped buffer
+	// マッピングされたバッファからアクセサの要素を直接読み取る型付きビューを返す
+	template <typename T>
+	AccessorView<T> getAccessor(const GLTFAccessor& accessor);
+
+	// Extracts index data from an accessor into the mesh, keeping 16-bit indices 16-bit
+	// アクセサからメッシュにインデックスデータを抽出する（16ビットのインデックスは16ビットのまま）
+	void getIndices(const GLTFAccessor& accessor, MeshData& mesh);
+
+	// Runs the mesh optimizer over the decoded mesh and builds its levels of detail, then narrows
+	// the indices again if they fit in 16 bits
+	// デコードしたメッシュにメッシュオプティマイザをかけて詳細度レベルを作り、
+	// 16ビットに収まればインデックスを再び縮める
+	void optimizeMesh(MeshData& mesh);
+
+	// Decodes the images defined in the model file
+	// モデルファイルで定義された画像をデコードする
+	void getImages();
+
+	// Decodes one image from its file or its buffer view
+	// 1つの画像をファイルまたはバッファビューからデコードする
+	void decodeImage(const GLTFImage& image, const std::string& fileDirectory, const char* texType);
+
+	// Interleaves positions, normals, and UVs into Vertex objects in a single pass
+	// 位置・法線・UVを1回の走査でVertexオブジェクトにインターリーブする
+	std::vector<Vertex> assembleVertices
+	(
+		const AccessorView<glm::vec3>& positions,
+		const AccessorView<glm::vec3>& normals,
+		const AccessorView<glm::vec2>& texUVs
+	);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "Profiling.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Asks the operating system for the largest amount of memory the process has held
+// プロセスがこれまでに保持した最大メモリ量をOSに問い合わせる
+size_t get_peak_resident_bytes()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+	return 0;
+#else
+	// ru_maxrss is reported in kilobytes on Linux
+	// Linuxではru_maxrssはキロバイト単位で報告される
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return (size_t)usage.ru_maxrss * 1024;
+	return 0;
+#endif
+}
\ No newline at end of file
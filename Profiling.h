@@ -0,0 +1,35 @@
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <cstddef>
+
+// Memory held by one subsystem, split by where it lives
+// 1つのサブシステムが保持するメモリ（置き場所ごとに分ける）
+struct MemoryUsage
+{
+	// Heap memory on the CPU side
+	// CPU側のヒープメモリ
+	size_t cpuBytes = 0;
+
+	// GPU buffer objects (vertex, index and pixel buffers)
+	// GPUのバッファオブジェクト（頂点・インデックス・ピクセルバッファ）
+	size_t bufferBytes = 0;
+
+	// GPU textures
+	// GPUのテクスチャ
+	size_t textureBytes = 0;
+
+	inline MemoryUsage& operator+=(const MemoryUsage& other)
+	{
+		cpuBytes += other.cpuBytes;
+		bufferBytes += other.bufferBytes;
+		textureBytes += other.textureBytes;
+		return *this;
+	}
+};
+
+// Returns the peak resident set size (peak working set on Windows) of the process in bytes
+// プロセスのピーク常駐メモリサイズ（Windowsではピークワーキングセット）をバイト単位で返す
+size_t get_peak_resident_bytes();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "RenderQueue.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+// Bit layout of the sort key, most significant field first:
+// | pass 2 | program 6 | material 12 | geometry 12 | level of detail 2 | depth 30 |
+// ソートキーのビット配置（上位のフィールドから順に）:
+// | パス 2 | プログラム 6 | マテリアル 12 | ジオメトリ 12 | 詳細度レベル 2 | 深度 30 |
+static const unsigned int DEPTH_BITS = 30;
+static const unsigned int LOD_SHIFT = 30;
+static const unsigned int GEOMETRY_SHIFT = 32;
+static const unsigned int MATERIAL_SHIFT = 44;
+static const unsigned int PROGRAM_SHIFT = 56;
+static const unsigned int PASS_SHIFT = 62;
+
+static const uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1;
+static const uint32_t LOD_MASK = (1u << (GEOMETRY_SHIFT - LOD_SHIFT)) - 1;
+static const uint32_t MAX_PROGRAMS = 1u << (PASS_SHIFT - PROGRAM_SHIFT);
+static const uint32_t MAX_MATERIALS = 1u << (PROGRAM_SHIFT - MATERIAL_SHIFT);
+static const uint32_t MAX_GEOMETRIES = 1u << (MATERIAL_SHIFT - GEOMETRY_SHIFT);
+
+static_assert(MAX_MESH_LODS <= LOD_MASK + 1, "Every level of detail must fit in the key");
+
+// Attribute locations of the per-instance data (matrices take one location per column)
+// インスタンスごとのデータの属性ロケーション（行列は列ごとに1つのロケーションを使う）
+static const GLuint INSTANCE_WORLD_LOCATION = 3;
+static const GLuint INSTANCE_NORMAL_LOCATION = 7;
+static const GLuint INSTANCE_FACE_LAYER_LOCATION = 10;
+
+RenderQueue::RenderQueue()
+{
+	instanceBuffer = GLBuffer::Create();
+}
+
+uint32_t RenderQueue::findProgram(Shader* shader)
+{
+	for (uint32_t i = 0; i < (uint32_t)programs.size(); i++)
+		if (programs[i] == shader)
+			return i;
+
+	if (programs.size() >= MAX_PROGRAMS)
+		throw std::out_of_range("Too many programs in one frame for the render queue's sort key");
+
+	programs.push_back(shader);
+	return (uint32_t)programs.size() - 1;
+}
+
+uint32_t RenderQueue::findMaterial(Model* model)
+{
+	// Material 0 is the shared face array
+	// マテリアル0は共有の表面配列
+	if (materials.empty())
+		materials.push_back(nullptr);
+
+	for (uint32_t i = 1; i < (uint32_t)materials.size(); i++)
+		if (materials[i] == model)
+			return i;
+
+	if (materials.size() >= MAX_MATERIALS)
+		throw std::out_of_range("Too many materials in one frame for the render queue's sort key");
+
+	materials.push_back(model);
+	return (uint32_t)materials.size() - 1;
+}
+
+uint32_t RenderQueue::findGeometry(const std::shared_ptr<Geometry>& geometry)
+{
+	// A board holds few distinct geometries, so a linear search is enough
+	// ボード上の異なるジオメトリは少ないため、線形探索で十分
+	for (uint32_t i = 0; i < (uint32_t)geometries.size(); i++)
+		if (geometries[i].geometry == geometry)
+			return i;
+
+	if (geometries.size() >= MAX_GEOMETRIES)
+		throw std::out_of_range("Too many geometries for the render queue's sort key");
+
+	geometries.emplace_back();
+	GeometryEntry& entry = geometries.back();
+	entry.geometry = geometry;
+
+	// Link the geometry's own buffers, then enable the instance attributes, which advance once per instance
+	// (their pointers are set per draw, since each run starts at a different offset of the instance buffer)
+	// ジオメトリ自身のバッファをリンクし、インスタンスごとに1つ進むインスタンス属性を有効にする
+	// （各並びはインスタンスバッファの異なるオフセットから始まるため、ポインタは描画ごとに設定する）
+	entry.VAO.Bind();
+	geometry->EBO.Bind();
+	entry.VAO.LinkLayout(geometry->VBO, geometry->layout);
+	for (GLuint location = INSTANCE_WORLD_LOCATION; location <= INSTANCE_FACE_LAYER_LOCATION; location++)
+	{
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+	entry.VAO.Unbind();
+	geometry->EBO.Unbind();
+
+	return (uint32_t)geometries.size() - 1;
+}
+
+void RenderQueue::Submit(Shader& shader, Model& model, const glm::mat4& transform, const Camera& camera, RenderPass pass)
+{
+	uint64_t program = findProgram(&shader);
+
+	// Models drawn from a face layer all share the face array, so only models with textures of their own get a material
+	// 表面レイヤーから描画するモデルはすべて表面配列を共有するため、自身のテクスチャを持つモデルのみマテリアルを持つ
+	int faceLayer = model.GetFaceLayer();
+	uint64_t material = faceLayer >= 0 ? 0 : findMaterial(&model);
+
+	const std::vector<Mesh>& meshes = model.GetMeshes();
+	const std::vector<glm::mat4>& matrices = model.GetMeshMatrices();
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		glm::mat4 world = Mesh::WorldMatrix(transform * matrices[i]);
+		uint64_t lod = meshes[i].SelectLod(world, camera);
+		uint64_t geometry = findGeometry(meshes[i].geometry);
+
+		// Depth is the distance to the mesh's center; the bits of a non-negative float sort like the float itself,
+		// and dropping the always-zero sign bit leaves 30 bits
+		// 深度はメッシュの中心までの距離（負でない浮動小数点のビットは値と同じ順に並び、常に0の符号ビットを除くと30ビットになる）
+		float distance = glm::length(glm::vec3(world * glm::vec4(meshes[i].geometry->lods.center, 1.0f)) - camera.cameraPosition);
+		uint32_t bits;
+		std::memcpy(&bits, &distance, sizeof(bits));
+		uint64_t depth = (uint64_t)(bits >> 1) & DEPTH_MASK;
+		if (pass == RENDER_PASS_TRANSPARENT)
+			depth = DEPTH_MASK - depth;
+
+		DrawPacket packet;
+		packet.key = ((uint64_t)pass << PASS_SHIFT) | (program << PROGRAM_SHIFT) | (material << MATERIAL_SHIFT)
+			| (geometry << GEOMETRY_SHIFT) | (lod << LOD_SHIFT) | depth;
+		packet.world = (uint32_t)worlds.size();
+		packet.faceLayer = faceLayer;
+
+		worlds.push_back(world);
+		packets.push_back(packet);
+	}
+}
+
+void RenderQueue::sortPackets()
+{
+	size_t count = packets.size();
+	scratch.resize(count);
+
+	// Least significant byte first; each pass is stable, so earlier bytes stay in order within equal later ones
+	// 最下位のバイトから（各パスは安定なため、後のバイトが等しい中では前のバイトの順序が保たれる）
+	for (unsigned int shift = 0; shift < 64; shift += 8)
+	{
+		size_t offsets[256] = {};
+		for (const DrawPacket& packet : packets)
+			offsets[(packet.key >> shift) & 0xFF]++;
+
+		// A byte every key shares would leave the order as it is
+		// すべてのキーで等しいバイトは順序を変えない
+		if (offsets[(packets[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		size_t start = 0;
+		for (size_t& offset : offsets)
+		{
+			size_t bucket = offset;
+			offset = start;
+			start += bucket;
+		}
+
+		for (const DrawPacket& packet : packets)
+			scratch[offsets[(packet.key >> shift) & 0xFF]++] = packet;
+		packets.swap(scratch);
+	}
+}
+
+void RenderQueue::Flush()
+{
+	drawCalls = 0;
+	instanceCount = 0;
+
+	if (!packets.empty())
+	{
+		sortPackets();
+
+		// Lay the instances out in sorted order, so every run is one contiguous range of the buffer
+		// インスタンスをソート順に並べる（各並びがバッファ内の連続した1つの範囲になる）
+		instances.resize(packets.size());
+		for (size_t i = 0; i < packets.size(); i++)
+		{
+			Instance& instance = instances[i];
+			instance.world = worlds[packets[i].world];
+			instance.normal = Mesh::NormalMatrix(instance.world);
+			instance.faceLayer = (float)packets[i].faceLayer;
+		}
+
+		// Stream them into a fresh buffer store, so the GPU can keep reading last frame's
+		// 新しいバッファ領域に転送する（GPUは前のフレームの領域を読み続けられる）
+		GLsizeiptr bytes = (GLsizeiptr)(instances.size() * sizeof(Instance));
+		if (bytes > instanceBufferSize)
+			instanceBufferSize = bytes;
+		GLState::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, instanceBufferSize, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+		// Draw each run of packets whose keys differ only in depth, changing only the state that differs from the last run
+		// キーが深度のみ異なるパケットの並びごとに描画する（直前の並びと異なる状態のみ変更する）
+		const uint32_t NONE = 0xFFFFFFFFu;
+		uint32_t boundProgram = NONE;
+		uint32_t boundMaterial = NONE;
+		Shader* shader = nullptr;
+
+		size_t first = 0;
+		while (first < packets.size())
+		{
+			uint64_t state = packets[first].key >> LOD_SHIFT;
+			size_t last = first + 1;
+			while (last < packets.size() && (packets[last].key >> LOD_SHIFT) == state)
+				last++;
+
+			uint32_t program = (uint32_t)(packets[first].key >> PROGRAM_SHIFT) & (MAX_PROGRAMS - 1);
+			uint32_t material = (uint32_t)(packets[first].key >> MATERIAL_SHIFT) & (MAX_MATERIALS - 1);
+			uint32_t geometry = (uint32_t)(packets[first].key >> GEOMETRY_SHIFT) & (MAX_GEOMETRIES - 1);
+			uint32_t lod = (uint32_t)state & LOD_MASK;
+
+			if (program != boundProgram)
+			{
+				shader = programs[program];
+				shader->Activate();
+				boundProgram = program;
+				boundMaterial = NONE;
+			}
+
+			if (material != boundMaterial)
+			{
+				if (materials.size() > material && materials[material])
+					Mesh::BindTextures(*shader, materials[material]->GetTextures());
+				boundMaterial = material;
+			}
+
+			const Geometry& drawn = *geometries[geometry].geometry;
+			geometries[geometry].VAO.Bind();
+
+			// Point the instance attributes at this run (GL 3.3 has no base instance to offset them with)
+			// インスタンス属性をこの並びに向ける（GL 3.3にはオフセット用のベースインスタンスが無い）
+			size_t offset = first * sizeof(Instance);
+			for (GLuint column = 0; column < 4; column++)
+				glVertexAttribPointer(INSTANCE_WORLD_LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, world) + column * sizeof(glm::vec4)));
+			for (GLuint column = 0; column < 3; column++)
+				glVertexAttribPointer(INSTANCE_NORMAL_LOCATION + column, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, normal) + column * sizeof(glm::vec3)));
+			glVertexAttribPointer(INSTANCE_FACE_LAYER_LOCATION, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, faceLayer)));
+
+			const MeshLod& level = drawn.lods.levels[lod < drawn.lods.count ? lod : 0];
+			size_t indexSize = drawn.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+			glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)level.indexCount, drawn.indexType, (const void*)(level.firstIndex * indexSize), (GLsizei)(last - first));
+
+			drawCalls++;
+			instanceCount += (unsigned int)(last - first);
+			first = last;
+		}
+
+		GLState::BindVertexArray(0);
+		GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	packets.clear();
+	worlds.clear();
+	programs.clear();
+	materials.clear();
+
+	// Drop geometries nothing else uses any more (e.g. after their models were unloaded)
+	// 他に使うものが無くなったジオメトリを破棄する（例：モデルが解放された後）
+	for (size_t i = geometries.size(); i-- > 0;)
+		if (geometries[i].geometry.use_count() == 1)
+			geometries.erase(geometries.begin() + i);
+}
+
+MemoryUsage RenderQueue::GetMemoryUsage() const
+{
+	MemoryUsage usage;
+	usage.cpuBytes = (packets.capacity() + scratch.capacity()) * sizeof(DrawPacket) + worlds.capacity() * sizeof(glm::mat4)
+		+ instances.capacity() * sizeof(Instance);
+	usage.bufferBytes = (size_t)instanceBufferSize;
+	return usage;
+}
\ No newline at end of file
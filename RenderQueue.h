@@ -0,0 +1,133 @@
+#ifndef RENDER_QUEUE_CLASS_H
+#define RENDER_QUEUE_CLASS_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "Model.h"
+
+// Passes drawn one after the other; opaque meshes go front to back, transparent ones back to front
+// 順に描画するパス（不透明なメッシュは手前から奥へ、半透明なメッシュは奥から手前へ）
+enum RenderPass : uint32_t
+{
+	RENDER_PASS_OPAQUE = 0,
+	RENDER_PASS_TRANSPARENT = 1
+};
+
+// One mesh to draw: a sort key, the world matrix it is drawn with and its face layer (16 bytes)
+// The key holds, from the most significant bits down, the pass, program, material, geometry,
+// level of detail and depth, so sorting by it groups draws that share state and orders each group by depth.
+// 描画する1つのメッシュ：ソートキー・描画に使うワールド行列・表面レイヤー（16バイト）
+// キーは上位ビットから順にパス・プログラム・マテリアル・ジオメトリ・詳細度レベル・深度を持つため、
+// キーでソートすると状態を共有する描画がまとまり、各まとまりは深度順に並ぶ
+struct DrawPacket
+{
+	uint64_t key;
+	uint32_t world;
+	int32_t faceLayer;
+};
+
+static_assert(sizeof(DrawPacket) == 16, "DrawPacket must stay compact");
+
+// RenderQueue class that collects the frame's draws as packets, sorts them by key and submits them
+// Gameplay code submits models wherever it likes; Flush radix-sorts the packets and draws each run of packets that
+// share every key field but depth with one glDrawElementsInstanced, so state changes only between runs.
+// フレームの描画をパケットとして集め、キーでソートして発行するRenderQueueクラス
+// ゲームプレイのコードはどこからでもモデルを登録できる。Flushはパケットを基数ソートし、深度以外のすべての
+// キーのフィールドが等しいパケットの並びを1回のglDrawElementsInstancedで描画するため、状態は並びの間でのみ変わる
+class RenderQueue
+{
+public:
+
+	// Constructor that creates the instance buffer (call with a current GL context)
+	// インスタンスバッファを作成するコンストラクタ（GLコンテキストが有効な状態で呼ぶ）
+	RenderQueue();
+
+	// The queue owns GL objects, so it cannot be copied
+	// キューはGLオブジェクトを所有するため、コピーできない
+	RenderQueue(const RenderQueue&) = delete;
+	RenderQueue& operator=(const RenderQueue&) = delete;
+
+	// Queues one packet per mesh of the model placed by transform, picking each mesh's level of detail
+	// The model must stay alive until Flush.
+	// transformで配置されるモデルのメッシュごとに1つのパケットをキューに入れる（各メッシュの詳細度レベルも選ぶ）
+	// モデルはFlushまで生存していなければならない
+	void Submit(Shader& shader, Model& model, const glm::mat4& transform, const Camera& camera, RenderPass pass = RENDER_PASS_OPAQUE);
+
+	// Sorts the queued packets, draws them and empties the queue (call once per frame, after the face array is bound)
+	// キュー内のパケットをソートして描画し、キューを空にする（毎フレーム1回、表面配列をバインドした後に呼ぶ）
+	void Flush();
+
+	// Returns the number of draw calls and instances of the last Flush
+	// 直前のFlushの描画呼び出し数とインスタンス数を返す
+	inline unsigned int GetDrawCallCount() const { return drawCalls; }
+	inline unsigned int GetInstanceCount() const { return instanceCount; }
+
+	// Returns the memory of the packet and instance lists and of the instance buffer
+	// パケットとインスタンスのリスト、およびインスタンスバッファのメモリ量を返す
+	MemoryUsage GetMemoryUsage() const;
+
+private:
+
+	// Per-instance data read by default.vert (attribute locations 3-10)
+	// default.vertが読み取るインスタンスごとのデータ（属性ロケーション3〜10）
+	struct Instance
+	{
+		// World matrix of the mesh and its normal matrix (see Mesh::WorldMatrix)
+		// メッシュのワールド行列とその法線行列（Mesh::WorldMatrixを参照）
+		glm::mat4 world;
+		glm::mat3 normal;
+
+		// Layer of the shared face array (-1 uses the material's textures)
+		// 共有の表面配列のレイヤー（-1の場合はマテリアルのテクスチャを使う）
+		float faceLayer;
+	};
+
+	// Geometry drawn by the queue with the VAO that adds the instance buffer to its vertex and element buffers
+	// (kept across frames so the VAO is reused)
+	// キューが描画するジオメトリと、その頂点バッファ・エレメントバッファにインスタンスバッファを加えるVAO
+	// （VAOを再利用するため、フレームをまたいで保持する）
+	struct GeometryEntry
+	{
+		std::shared_ptr<Geometry> geometry;
+		VAO VAO;
+	};
+
+	// Tables the key fields index; programs and materials are rebuilt each frame (material 0 is the face array)
+	// キーのフィールドが指す表（プログラムとマテリアルは毎フレーム作り直す。マテリアル0は表面配列）
+	std::vector<Shader*> programs;
+	std::vector<Model*> materials;
+	std::vector<GeometryEntry> geometries;
+
+	// Packets of the frame, the scratch list the radix sort ping-pongs with, and the world matrices they index
+	// フレームのパケット、基数ソートが交互に使う作業用リスト、パケットが指すワールド行列
+	std::vector<DrawPacket> packets;
+	std::vector<DrawPacket> scratch;
+	std::vector<glm::mat4> worlds;
+
+	// Instances in sorted order, uploaded with one call
+	// ソート順に並べたインスタンス（1回の呼び出しで転送する）
+	std::vector<Instance> instances;
+
+	// Buffer the instances are streamed into each frame, and its size in bytes
+	// 毎フレームインスタンスを転送するバッファと、そのバイト数
+	GLBuffer instanceBuffer;
+	GLsizeiptr instanceBufferSize = 0;
+
+	// Statistics of the last Flush
+	// 直前のFlushの統計
+	unsigned int drawCalls = 0;
+	unsigned int instanceCount = 0;
+
+	// Returns the index of the program, material or geometry in its table, adding it on first use
+	// プログラム・マテリアル・ジオメトリの表内のインデックスを返す（初めて使うときに追加する）
+	uint32_t findProgram(Shader* shader);
+	uint32_t findMaterial(Model* model);
+	uint32_t findGeometry(const std::shared_ptr<Geometry>& geometry);
+
+	// Sorts the packets by key, eight bits per pass, skipping bytes every key shares
+	// パケットをキーで8ビットずつソートする（すべてのキーで等しいバイトは飛ばす）
+	void sortPackets();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "TextureArray.h"
+
+TextureArray::TextureArray(const TextureImage& image, int layerCount, GLuint slot)
+	: unit(slot), width(image.width), height(image.height), layers(layerCount)
+{
+	internalFormat = image.IsCompressed() ? image.internalFormat : GL_RGBA8;
+
+	ID = GLTexture::Create();
+	GLState::BindTexture(slot, GL_TEXTURE_2D_ARRAY, ID);
+
+	// Trilinear filtering, as for the individual card textures
+	// 個別のカードテクスチャと同じくトライリニアフィルタリング
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	// Allocate every mip level for all layers up front; layers are filled in later
+	// すべてのレイヤーの全ミップレベルを先に確保する（レイヤーは後で埋める）
+	TextureImage layout = image;
+	layout.generateMipmap = true;
+	levelCount = layout.GetLevelCount();
+	for (int level = 0; level < levelCount; level++)
+	{
+		int levelWidth = layout.GetLevelWidth(level);
+		int levelHeight = layout.GetLevelHeight(level);
+		size_t levelBytes = layout.GetRowBytes(level) * layout.GetRowCount(level);
+
+		if (layout.IsCompressed())
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, levelWidth, levelHeight, layers, 0, (GLsizei)(levelBytes * layers), nullptr);
+		else
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, levelWidth, levelHeight, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+	// RGBA storage takes 4 bytes per texel whatever the channels of the first image
+	// RGBAストレージは最初の画像のチャンネル数に関係なく1テクセル4バイトを使う
+	if (layout.IsCompressed())
+		layerBytes = layout.GetBytes();
+	else
+		layerBytes = TextureImage(nullptr, width, height, 4, 0).GetBytes();
+
+	GLState::BindTexture(slot, GL_TEXTURE_2D_ARRAY, 0);
+}
+
+bool TextureArray::Fits(const TextureImage& image) const
+{
+	if (image.width != width || image.height != height)
+		return false;
+
+	if (internalFormat == GL_RGBA8)
+		return !image.IsCompressed();
+
+	return image.internalFormat == internalFormat && (int)image.levels.size() == levelCount;
+}
+
+void TextureArray::SetLayer(int layer, const TextureImage& image)
+{
+	GLState::BindTexture(GL_TEXTURE_2D_ARRAY, ID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// Upload the given levels, each half the size of the previous one
+	// 与えられたレベルを転送する（各レベルは前のレベルの半分のサイズ）
+	for (int level = 0; level < (int)image.levels.size(); level++)
+	{
+		int levelWidth = image.GetLevelWidth(level);
+		int levelHeight = image.GetLevelHeight(level);
+		const ByteRange& pixels = image.levels[level];
+
+		if (image.IsCompressed())
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1, internalFormat, (GLsizei)pixels.size, pixels.data);
+		else
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1, image.format, GL_UNSIGNED_BYTE, pixels.data);
+	}
+
+	// Without pre-built mips, rebuild the chain (this covers every layer)
+	// 事前に作成されたミップが無い場合はチェーンを作り直す（全レイヤーが対象になる）
+	if (image.generateMipmap)
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	GLState::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::texUnit(Shader& shader, const char* uniform, GLuint unit)
+{
+	shader.Activate();
+	shader.SetInt(uniform, (GLint)unit);
+}
+
+// Binds the texture array to its unit
+// テクスチャ配列をユニットにバインドする
+void TextureArray::Bind()
+{
+	GLState::BindTexture(unit, GL_TEXTURE_2D_ARRAY, ID);
+}
+
+// Unbinds the texture array
+// テクスチャ配列のバインドを解除する
+void TextureArray::Unbind()
+{
+	GLState::BindTexture(unit, GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// Deletes the texture array
+// テクスチャ配列を削除する
+void TextureArray::Delete()
+{
+	ID.Reset();
+}
\ No newline at end of file
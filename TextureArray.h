@@ -0,0 +1,87 @@
+#ifndef TEXTURE_ARRAY_CLASS_H
+#define TEXTURE_ARRAY_CLASS_H
+
+#include <glad/glad.h>
+#include "shaderClass.h"
+#include "TextureImage.h"
+#include "GLHandle.h"
+
+// TextureArray class holding same-sized images as layers of one GL_TEXTURE_2D_ARRAY,
+// so every card face can be sampled with a single bind and a layer index
+// 同じサイズの画像を1つのGL_TEXTURE_2D_ARRAYのレイヤーとして保持するTextureArrayクラス
+// すべてのカードの表面を1回のバインドとレイヤー番号でサンプリングできる
+class TextureArray
+{
+public:
+
+	// OpenGL texture object, deleted with the array
+	// OpenGLのテクスチャオブジェクト（配列と共に削除される）
+	GLTexture ID;
+
+	// Texture unit slot number
+	// テクスチャユニットのスロット番号
+	GLuint unit;
+
+	// Constructor that allocates storage for every layer and its full mip chain, shaped after the given image:
+	// block-compressed if the image is, RGBA otherwise
+	// 与えられた画像に合わせて、すべてのレイヤーとその完全なミップチェーン用のストレージを確保するコンストラクタ
+	// 画像がブロック圧縮されていれば同じ圧縮フォーマット、そうでなければRGBA
+	TextureArray(const TextureImage& image, int layerCount, GLuint slot);
+
+	// Uploads an image into one layer right away
+	// 画像を1つのレイヤーにすぐに転送する
+	void SetLayer(int layer, const TextureImage& image);
+
+	// Returns true if the image can be stored in a layer: same size, and for compressed arrays
+	// the same format with every mip level (uncompressed arrays take any channel count)
+	// 画像をレイヤーに格納できればtrueを返す：同じサイズで、圧縮配列の場合はすべてのミップレベルを持つ
+	// 同じフォーマット（非圧縮配列は任意のチャンネル数を受け付ける）
+	bool Fits(const TextureImage& image) const;
+
+	// Returns the storage format
+	// ストレージのフォーマットを返す
+	inline GLenum GetInternalFormat() const { return internalFormat; }
+
+	// Returns the number of layers
+	// レイヤー数を返す
+	inline int GetLayerCount() const { return layers; }
+
+	// Returns the GPU memory one layer takes, mips included
+	// 1レイヤーが使用するGPUメモリ量を返す（ミップを含む）
+	inline size_t GetLayerBytes() const { return layerBytes; }
+
+	// Assigns the texture unit to a shader uniform
+	// シェーダーのuniform変数にテクスチャユニットを割り当てる
+	void texUnit(Shader& shader, const char* uniform, GLuint unit);
+
+	// Binds the texture array
+	// テクスチャ配列をバインドする
+	void Bind();
+
+	// Unbinds the texture array
+	// テクスチャ配列のバインドを解除する
+	void Unbind();
+
+	// Deletes the texture array
+	// テクスチャ配列を削除する
+	void Delete();
+
+private:
+
+	// Size of level 0 of every layer
+	// 各レイヤーのレベル0のサイズ
+	int width;
+	int height;
+
+	// Number of layers and mip levels, and the storage format
+	// レイヤー数・ミップレベル数・ストレージのフォーマット
+	int layers;
+	int levelCount = 0;
+	GLenum internalFormat;
+
+	// Bytes per layer, mips included
+	// 1レイヤーあたりのバイト数（ミップを含む）
+	size_t layerBytes = 0;
+};
+
+#endif
\ No newline at end of file
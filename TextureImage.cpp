@@ -0,0 +1,121 @@
+#include "TextureImage.h"
+
+#include <stdexcept>
+
+TextureImage::TextureImage(const unsigned char* pixels, int widthImg, int heightImg, int numColCh, int mipLevels)
+	: width(widthImg), height(heightImg), channels(numColCh)
+{
+	// Sized internal formats that match the channels, so RGB and single-channel images are not stored as RGBA
+	// (the game lights in gamma space, so colors stay UNORM rather than sRGB)
+	// チャンネル数に合うサイズ付き内部フォーマット（RGBや1チャンネルの画像をRGBAとして格納しない）
+	// （ゲームはガンマ空間でライティングするため、色はsRGBではなくUNORMのままにする）
+	if (numColCh == 4)
+	{
+		internalFormat = GL_RGBA8;
+		format = GL_RGBA;
+	}
+	else if (numColCh == 3)
+	{
+		internalFormat = GL_RGB8;
+		format = GL_RGB;
+	}
+	else if (numColCh == 1)
+	{
+		internalFormat = GL_R8;
+		format = GL_RED;
+	}
+	else
+		throw std::invalid_argument("Automatic Texture type recognition failed");
+
+	generateMipmap = mipLevels == 0;
+	int levelCount = mipLevels > 0 ? mipLevels : 1;
+	for (int level = 0; level < levelCount; level++)
+	{
+		ByteRange range;
+		range.data = pixels;
+		range.size = GetRowBytes(level) * GetRowCount(level);
+		levels.push_back(range);
+
+		if (pixels)
+			pixels += range.size;
+	}
+}
+
+TextureImage::TextureImage(const KTX2Image& ktx)
+	: width((int)ktx.width), height((int)ktx.height), levels(ktx.levels)
+{
+	switch (ktx.vkFormat)
+	{
+	case KTX2_FORMAT_R8_UNORM:             internalFormat = GL_R8;           format = GL_RED;  channels = 1; break;
+	case KTX2_FORMAT_R8G8B8_UNORM:         internalFormat = GL_RGB8;         format = GL_RGB;  channels = 3; break;
+	case KTX2_FORMAT_R8G8B8_SRGB:          internalFormat = GL_SRGB8;        format = GL_RGB;  channels = 3; break;
+	case KTX2_FORMAT_R8G8B8A8_UNORM:       internalFormat = GL_RGBA8;        format = GL_RGBA; channels = 4; break;
+	case KTX2_FORMAT_R8G8B8A8_SRGB:        internalFormat = GL_SRGB8_ALPHA8; format = GL_RGBA; channels = 4; break;
+	case KTX2_FORMAT_BC1_RGB_UNORM:        internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;        channels = 3; break;
+	case KTX2_FORMAT_BC1_RGB_SRGB:         internalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;       channels = 3; break;
+	case KTX2_FORMAT_BC3_UNORM:            internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;       channels = 4; break;
+	case KTX2_FORMAT_BC3_SRGB:             internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT; channels = 4; break;
+	default:
+		throw std::invalid_argument("KTX2 texture format is not supported");
+	}
+}
+
+int TextureImage::GetLevelCount() const
+{
+	if (!generateMipmap)
+		return (int)levels.size();
+
+	// A generated chain goes all the way down to 1x1
+	// 生成されるチェーンは1x1まで続く
+	int count = 1;
+	while (GetLevelWidth(count - 1) > 1 || GetLevelHeight(count - 1) > 1)
+		count++;
+	return count;
+}
+
+size_t TextureImage::GetBytes() const
+{
+	size_t bytes = 0;
+	for (int level = 0; level < GetLevelCount(); level++)
+		bytes += GetRowBytes(level) * GetRowCount(level);
+
+	// Drivers pad 3-byte texels to 4, so count RGB storage as RGBA
+	// ドライバは3バイトのテクセルを4バイトに詰め直すため、RGBストレージはRGBAとして数える
+	if (!IsCompressed() && channels == 3)
+		bytes = bytes / 3 * 4;
+
+	return bytes;
+}
+
+size_t TextureImage::GetRowBytes(int level) const
+{
+	if (IsCompressed())
+	{
+		size_t blockBytes = internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || internalFormat == GL_COMPRESSED_SRGB_S3TC_DXT1_EXT ? 8 : 16;
+		return (size_t)((GetLevelWidth(level) + 3) / 4) * blockBytes;
+	}
+
+	return (size_t)GetLevelWidth(level) * channels;
+}
+
+int TextureImage::GetRowCount(int level) const
+{
+	return IsCompressed() ? (GetLevelHeight(level) + 3) / 4 : GetLevelHeight(level);
+}
+
+const char* texture_format_name(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_R8: return "R8";
+	case GL_RGB8: return "RGB8";
+	case GL_SRGB8: return "SRGB8";
+	case GL_RGBA8: return "RGBA8";
+	case GL_SRGB8_ALPHA8: return "SRGB8_A8";
+	case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return "BC1";
+	case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT: return "BC1_SRGB";
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return "BC3";
+	case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: return "BC3_SRGB";
+	default: return "?";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef TEXTURE_IMAGE_CLASS_H
+#define TEXTURE_IMAGE_CLASS_H
+
+#include <vector>
+#include <glad/glad.h>
+#include "MappedFile.h"
+#include "KTX2.h"
+
+// S3TC formats come from an extension that a core-profile loader may leave out
+// S3TCフォーマットは拡張機能のものであり、コアプロファイルのローダーには含まれない場合がある
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// TextureImage class describing the pixels of one texture and the GL formats they are uploaded with
+// The pixels themselves are not owned; they live in a decoded image or a mapped card pack.
+// 1つのテクスチャのピクセルと、それを転送するときのGLフォーマットを記述するTextureImageクラス
+// ピクセル自体は所有しない（デコード済み画像またはマッピングされたカードパック内にある）
+class TextureImage
+{
+public:
+
+	// Size of level 0 and number of color channels
+	// レベル0のサイズとカラーチャンネル数
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+
+	// Storage format (sized or block-compressed), and the pixel format of uncompressed uploads (0 if compressed)
+	// ストレージのフォーマット（サイズ付きまたはブロック圧縮）と、非圧縮転送時のピクセルフォーマット（圧縮の場合は0）
+	GLenum internalFormat = 0;
+	GLenum format = 0;
+
+	// Mip levels, largest first
+	// ミップレベル（最大レベルから順）
+	std::vector<ByteRange> levels;
+
+	// Set when only level 0 is given and the rest of the chain is generated on the GPU
+	// レベル0のみが与えられ、残りのチェーンをGPUで生成する場合にセットされる
+	bool generateMipmap = false;
+
+	// Constructor that creates an empty image
+	// 空の画像を作成するコンストラクタ
+	TextureImage() = default;
+
+	// Constructor for tightly packed 8-bit pixels
+	// mipLevels levels follow one another (largest first); 0 means only level 0 is given
+	// 隙間なく詰められた8ビットのピクセル用のコンストラクタ
+	// mipLevels個のレベルが順に続く（最大レベルから）。0の場合はレベル0のみ
+	TextureImage(const unsigned char* pixels, int widthImg, int heightImg, int numColCh, int mipLevels);
+
+	// Constructor for a KTX2 texture (throws std::invalid_argument for formats GL cannot take)
+	// KTX2テクスチャ用のコンストラクタ（GLが扱えないフォーマットの場合はstd::invalid_argumentを投げる）
+	TextureImage(const KTX2Image& ktx);
+
+	// Returns true if the image is block-compressed
+	// 画像がブロック圧縮されていればtrueを返す
+	inline bool IsCompressed() const { return format == 0; }
+
+	// Returns the number of mip levels the GPU texture will have
+	// GPUテクスチャが持つミップレベル数を返す
+	int GetLevelCount() const;
+
+	// Returns the GPU memory the texture takes, every mip level included
+	// テクスチャが使用するGPUメモリ量を返す（すべてのミップレベルを含む）
+	size_t GetBytes() const;
+
+	// Returns the bytes of one row of pixels (or of 4x4 blocks, if compressed) and the number of such rows in a level
+	// 1行のピクセル（圧縮の場合は4x4ブロック）のバイト数と、レベル内のその行数を返す
+	size_t GetRowBytes(int level) const;
+	int GetRowCount(int level) const;
+
+	// Returns the size of a mip level
+	// ミップレベルのサイズを返す
+	inline int GetLevelWidth(int level) const { return width >> level > 0 ? width >> level : 1; }
+	inline int GetLevelHeight(int level) const { return height >> level > 0 ? height >> level : 1; }
+};
+
+// Returns a short name for an internal format, for reports
+// 報告用に内部フォーマットの短い名前を返す
+const char* texture_format_name(GLenum internalFormat);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "TextureResidency.h"
+
+// Texture unit of the face array, the first one past the units of the models' own textures
+// (a sampler2DArray must never share a unit with their sampler2Ds)
+// 表面配列のテクスチャユニット（モデル自身のテクスチャのユニットの次。sampler2DArrayは
+// それらのsampler2Dとユニットを共有してはならない）
+static const GLuint FACE_UNIT = MESH_TEXTURE_UNITS;
+
+// Share of the budget given to the face array; the rest is left for models with textures of their own
+// 表面配列に割り当てる予算の割合（残りは自身のテクスチャを持つモデルに残す）
+static const size_t FACE_BUDGET_DIVISOR = 2;
+
+TextureResidency::TextureResidency(TextureStreamer& streamer, size_t budgetBytes)
+	: streamer(streamer), budget(budgetBytes)
+{
+}
+
+void TextureResidency::Request(const std::shared_ptr<Model>& model)
+{
+	// The meshes must exist before textures can be attached to them
+	// テクスチャを付けるには先にメッシュが存在しなければならない
+	if (!model || !model->IsUploaded())
+		return;
+
+	// Already resident: move it to the front of the list
+	// 常駐済みの場合はリストの先頭に移動する
+	auto found = lookup.find(model.get());
+	if (found != lookup.end())
+	{
+		found->second->lastUsed = frame;
+		entries.splice(entries.begin(), entries, found->second);
+		return;
+	}
+
+	// Textures created by someone else are not ours to evict
+	// 他で作成されたテクスチャは退避の対象外
+	if (model->HasTextures())
+		return;
+
+	place(model, false);
+	trim();
+}
+
+void TextureResidency::Pin(const std::shared_ptr<Model>& model)
+{
+	if (!model || !model->IsUploaded())
+		return;
+
+	auto found = lookup.find(model.get());
+	if (found != lookup.end())
+	{
+		found->second->pinned = true;
+		return;
+	}
+
+	// Move textures the model created itself into the array (they are complete, so this cannot fail
+	// unless they are still streaming or their pixels are gone, in which case the model keeps them)
+	// モデルが自身で作成したテクスチャを配列に移す（完成していれば失敗しない。
+	// ストリーミング中かピクセルが解放済みの場合はモデルがそのまま保持する）
+	if (model->HasTextures() && (!model->HasPixels() || !model->ReleaseTextures()))
+		return;
+
+	place(model, true);
+}
+
+void TextureResidency::Release(const std::shared_ptr<Model>& model)
+{
+	auto found = lookup.find(model.get());
+	if (found != lookup.end())
+		evict(found->second);
+}
+
+void TextureResidency::Bind(Shader& shader)
+{
+	// The sampler is pointed at its own unit even without an array, since two samplers
+	// of different types must never share a unit
+	// 配列が無くてもサンプラーは専用のユニットに向ける（型の異なる2つのサンプラーが
+	// 同じユニットを共有してはならないため）
+	shader.Activate();
+	shader.SetInt("faces", (GLint)FACE_UNIT);
+
+	if (faces)
+		faces->Bind();
+}
+
+void TextureResidency::Update()
+{
+	frame++;
+	trim();
+}
+
+void TextureResidency::place(const std::shared_ptr<Model>& model, bool pinned)
+{
+	// Create the face array from the first face, with as many layers as its share of the budget allows
+	// 最初の表面から、予算のうち表面配列の割り当てが許す数のレイヤーを持つ表面配列を作成する
+	const Model::TextureSource* face = model->GetFaceSource();
+	if (face && !faces)
+	{
+		// One layer costs as much as the face would as a texture of its own (RGBA if uncompressed)
+		// 1レイヤーは、その表面を単独のテクスチャにした場合と同じ量を使う（非圧縮の場合はRGBA）
+		size_t layerBytes = face->image.IsCompressed() ? face->image.GetBytes() : TextureImage(nullptr, face->image.width, face->image.height, 4, 0).GetBytes();
+		int layerCount = (int)(budget / FACE_BUDGET_DIVISOR / layerBytes);
+		if (layerCount < 2)
+			layerCount = 2;
+
+		faces.reset(new TextureArray(face->image, layerCount, FACE_UNIT));
+		for (int layer = layerCount - 1; layer >= 0; layer--)
+			freeLayers.push_back(layer);
+
+		// The whole array is allocated up front, so it is charged to the budget once here
+		// 配列全体は最初に確保されるため、ここで一度だけ予算に計上する
+		residentBytes += faces->GetLayerBytes() * faces->GetLayerCount();
+	}
+
+	Entry entry;
+	entry.model = model;
+	entry.layer = -1;
+	entry.lastUsed = frame;
+	entry.pinned = pinned;
+
+	// Faces that match the array's size take a layer; pinned models are uploaded right away
+	// 配列のサイズに合う表面はレイヤーを使う（固定されたモデルはすぐに転送する）
+	TextureStreamer* upload = pinned ? nullptr : &streamer;
+	if (face && faces->Fits(face->image) && (!freeLayers.empty() || freeLayer()))
+	{
+		entry.layer = freeLayers.back();
+		freeLayers.pop_back();
+		model->CreateFaceLayer(*faces, entry.layer, upload);
+
+		// The layer was already paid for when the array was created
+		// レイヤーの分は配列の作成時に計上済み
+		entry.bytes = 0;
+	}
+	else
+	{
+		model->CreateTextures(upload);
+		entry.bytes = model->GetTextureBytes();
+	}
+
+	entries.push_front(entry);
+	lookup[model.get()] = entries.begin();
+
+	residentBytes += entry.bytes;
+	uploads++;
+}
+
+bool TextureResidency::freeLayer()
+{
+	for (auto entry = entries.end(); entry != entries.begin();)
+	{
+		--entry;
+		if (entry->lastUsed + 1 >= frame)
+			return false;
+
+		if (entry->layer >= 0 && evict(entry))
+			return true;
+	}
+	return false;
+}
+
+void TextureResidency::trim()
+{
+	// Walk from the least recently used end, skipping textures drawn in the last frame
+	// (evicting those would only bring them straight back)
+	// 最も長く使われていない側から順に見る（直前のフレームで描画されたテクスチャは飛ばす。
+	// 退避してもすぐに戻ってくるだけのため）
+	auto entry = entries.end();
+	while (residentBytes > budget && entry != entries.begin())
+	{
+		--entry;
+		if (entry->lastUsed + 1 >= frame)
+			break;
+
+		// Evicting a face frees no memory, since the array keeps its layers
+		// 表面を退避してもメモリは解放されない（配列はレイヤーを保持したままのため）
+		if (entry->layer >= 0)
+			continue;
+
+		auto older = entry;
+		++entry;
+		if (!evict(older))
+			--entry;
+	}
+}
+
+bool TextureResidency::evict(std::list<Entry>::iterator entry)
+{
+	if (entry->pinned)
+		return false;
+
+	if (entry->layer >= 0)
+	{
+		if (!entry->model->ReleaseFaceLayer())
+			return false;
+		freeLayers.push_back(entry->layer);
+	}
+	else if (!entry->model->ReleaseTextures())
+	{
+		return false;
+	}
+
+	residentBytes -= entry->bytes;
+	evictions++;
+
+	lookup.erase(entry->model.get());
+	entries.erase(entry);
+	return true;
+}
+
+MemoryUsage TextureResidency::GetMemoryUsage() const
+{
+	MemoryUsage usage;
+	if (faces)
+		usage.textureBytes = faces->GetLayerBytes() * faces->GetLayerCount();
+	return usage;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef TEXTURE_RESIDENCY_CLASS_H
+#define TEXTURE_RESIDENCY_CLASS_H
+
+#include <list>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "Model.h"
+#include "TextureStreamer.h"
+#include "TextureArray.h"
+
+// TextureResidency class that keeps model textures on the GPU only while they are needed
+// Textures are created on request and the least recently used ones are evicted once the budget is exceeded.
+// Single-image models (the card faces) share the layers of one texture array, so the whole board
+// is drawn with one texture bind; models that do not fit get textures of their own.
+// モデルのテクスチャを必要な間だけGPUに置くTextureResidencyクラス
+// テクスチャは要求時に作成され、予算を超えると最も長く使われていないものから退避される
+// 画像が1枚のモデル（カードの表面）は1つのテクスチャ配列のレイヤーを共有するため、ボード全体を
+// 1回のテクスチャバインドで描画できる（収まらないモデルは自身のテクスチャを持つ）
+class TextureResidency
+{
+public:
+
+	// Constructor that streams requested textures through the given streamer
+	// 要求されたテクスチャを指定されたストリーマーで転送するコンストラクタ
+	TextureResidency(TextureStreamer& streamer, size_t budgetBytes = 64 * 1024 * 1024);
+
+	// Makes the model's textures resident (streaming them in if needed) and marks them as used this frame
+	// Models whose textures were created elsewhere are left alone
+	// モデルのテクスチャを常駐させ（必要なら転送し）、このフレームで使用済みとする
+	// テクスチャが他の場所で作成されたモデルは対象外
+	void Request(const std::shared_ptr<Model>& model);
+
+	// Makes the model's textures resident right away and never evicts them (e.g. the placeholder card)
+	// Textures the model already created itself are moved into the face array
+	// モデルのテクスチャをすぐに常駐させ、決して退避しない（例：プレースホルダーのカード）
+	// モデルが既に自身で作成したテクスチャは表面配列に移される
+	void Pin(const std::shared_ptr<Model>& model);
+
+	// Evicts the model's textures right away, e.g. once its card has been matched
+	// カードが揃った場合などに、モデルのテクスチャをすぐに退避する
+	void Release(const std::shared_ptr<Model>& model);
+
+	// Advances the frame and evicts textures over the budget (call once per frame)
+	// フレームを進め、予算を超えたテクスチャを退避する（毎フレーム1回呼ぶ）
+	void Update();
+
+	// Binds the face array and points the shader's "faces" sampler at it (call once per frame before drawing)
+	// 表面配列をバインドし、シェーダーの"faces"サンプラーをそこに向ける（毎フレーム描画前に1回呼ぶ）
+	void Bind(Shader& shader);
+
+	// Sets the GPU memory the managed textures may use, face array included
+	// (the array takes half of it, sized when first needed; textures of the models' own share the rest)
+	// 表面配列を含め、管理対象のテクスチャが使用できるGPUメモリ量を設定する
+	// （配列は初めて必要になったときにその半分を使い、モデル自身のテクスチャが残りを共有する）
+	inline void SetBudget(size_t budgetBytes) { budget = budgetBytes; }
+
+	// Returns the GPU memory budget
+	// GPUメモリの予算を返す
+	inline size_t GetBudget() const { return budget; }
+
+	// Returns the GPU memory used by the managed textures, face array included
+	// 表面配列を含め、管理対象のテクスチャが使用しているGPUメモリ量を返す
+	inline size_t GetResidentBytes() const { return residentBytes; }
+
+	// Returns the GPU memory of the face array (the models' own textures are reported by the models)
+	// 表面配列のGPUメモリ量を返す（モデル自身のテクスチャはモデルが報告する）
+	MemoryUsage GetMemoryUsage() const;
+
+	// Returns how many times textures were made resident
+	// テクスチャが常駐化された回数を返す
+	inline unsigned int GetUploadCount() const { return uploads; }
+
+	// Returns how many times textures were evicted
+	// テクスチャが退避された回数を返す
+	inline unsigned int GetEvictionCount() const { return evictions; }
+
+private:
+
+	// Model whose textures are resident, with its size, face layer (-1 for its own textures),
+	// the frame it was last used, and whether it may be evicted
+	// テクスチャが常駐しているモデルと、そのサイズ・表面レイヤー（自身のテクスチャの場合は-1）・
+	// 最後に使用されたフレーム・退避してよいかどうか
+	struct Entry
+	{
+		std::shared_ptr<Model> model;
+		size_t bytes;
+		int layer;
+		unsigned long long lastUsed;
+		bool pinned;
+	};
+
+	// Resident models, most recently used first
+	// 常駐しているモデル（最近使用された順）
+	std::list<Entry> entries;
+
+	// Position of each resident model in entries
+	// entries内の各常駐モデルの位置
+	std::unordered_map<const Model*, std::list<Entry>::iterator> lookup;
+
+	// Texture array shared by the card faces, and its unused layers
+	// カードの表面が共有するテクスチャ配列と、その未使用のレイヤー
+	std::unique_ptr<TextureArray> faces;
+	std::vector<int> freeLayers;
+
+	// Streamer that fills newly created textures
+	// 新しく作成されたテクスチャを埋めるストリーマー
+	TextureStreamer& streamer;
+
+	// GPU memory budget and current use
+	// GPUメモリの予算と現在の使用量
+	size_t budget;
+	size_t residentBytes = 0;
+
+	// Current frame, used to protect textures drawn in the last frame from eviction
+	// 現在のフレーム（直前のフレームで描画されたテクスチャを退避から守るために使う）
+	unsigned long long frame = 0;
+
+	// Counters for the report
+	// 報告用のカウンタ
+	unsigned int uploads = 0;
+	unsigned int evictions = 0;
+
+	// Creates the model's textures in a free face layer if it fits, otherwise as textures of its own
+	// モデルのテクスチャを、収まれば空いている表面レイヤーに、そうでなければ自身のテクスチャとして作成する
+	void place(const std::shared_ptr<Model>& model, bool pinned);
+
+	// Frees a face layer by evicting the least recently used face not drawn in the last frame
+	// 直前のフレームで描画されていない、最も長く使われていない表面を退避してレイヤーを空ける
+	bool freeLayer();
+
+	// Evicts least recently used textures until the budget is met
+	// 予算内に収まるまで、最も長く使われていないテクスチャを退避する
+	void trim();
+
+	// Evicts one entry, returning false if it is pinned or its textures are still streaming
+	// エントリを1つ退避する（テクスチャがまだストリーミング中の場合はfalseを返す）
+	bool evict(std::list<Entry>::iterator entry);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "TextureStreamer.h"
+
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+
+TextureStreamer::TextureStreamer(GLsizeiptr bytesPerFrame, unsigned int ringSize)
+	: fences(new GLsync[ringSize]), ringSize(ringSize), bytesPerFrame(bytesPerFrame)
+{
+	// Each frame fills a different PBO, so the GPU can still be reading the previous ones
+	// フレームごとに別のPBOを埋めるため、GPUは前のPBOを読み取り中でもよい
+	for (unsigned int i = 0; i < ringSize; i++)
+	{
+		pbos.push_back(GLBuffer::Create());
+		GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[i]);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, bytesPerFrame, nullptr, GL_STREAM_DRAW);
+		fences[i] = nullptr;
+	}
+	GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	for (unsigned int i = 0; i < ringSize; i++)
+		if (fences[i])
+			glDeleteSync(fences[i]);
+}
+
+void TextureStreamer::Queue
+(
+	GLuint texture,
+	const TextureImage& image,
+	unsigned int* pending,
+	std::shared_ptr<const void> owner,
+	GLint layer
+)
+{
+	// Textures are uploaded in whole rows, so one row must fit in a frame's budget
+	// テクスチャは行単位で転送するため、1行が1フレームの予算に収まらなければならない
+	if ((GLsizeiptr)image.GetRowBytes(0) > bytesPerFrame)
+		throw std::invalid_argument("Texture row is larger than the streaming budget");
+
+	Job job;
+	job.texture = texture;
+	job.image = image;
+	job.pending = pending;
+	job.owner = std::move(owner);
+	job.layer = layer;
+
+	(*pending)++;
+	jobs.push_back(std::move(job));
+}
+
+void TextureStreamer::Update()
+{
+	if (jobs.empty())
+		return;
+
+	// Wait until the GPU has read this PBO (it was used ringSize frames ago, so this rarely blocks)
+	// GPUがこのPBOを読み終えるまで待つ（ringSizeフレーム前に使われたため、ほとんど待たない）
+	if (fences[next])
+	{
+		glClientWaitSync(fences[next], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+		glDeleteSync(fences[next]);
+		fences[next] = nullptr;
+	}
+
+	GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[next]);
+	unsigned char* mapped = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytesPerFrame, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (mapped == nullptr)
+	{
+		GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return;
+	}
+
+	// Band of rows copied into the PBO, uploaded once the buffer is unmapped
+	// PBOにコピーされた行の帯（バッファのマッピング解除後に転送する）
+	struct Band
+	{
+		GLuint texture;
+		GLint layer;
+		int level;
+		int y;
+		int width;
+		int height;
+		GLenum internalFormat;
+		GLenum format;
+		GLsizeiptr offset;
+		GLsizeiptr size;
+
+		// Set on the last band of a texture
+		// テクスチャの最後の帯で設定される
+		unsigned int* pending;
+		bool generateMipmap;
+	};
+	std::vector<Band> bands;
+
+	// Copy whole rows from the queued textures until the budget is spent
+	// 予算を使い切るまで、キュー内のテクスチャから行単位でコピーする
+	GLsizeiptr used = 0;
+	while (!jobs.empty())
+	{
+		Job& job = jobs.front();
+		const TextureImage& image = job.image;
+		GLsizeiptr rowBytes = (GLsizeiptr)image.GetRowBytes(job.level);
+		int rowCount = image.GetRowCount(job.level);
+		int rows = (int)((bytesPerFrame - used) / rowBytes);
+		if (rows > rowCount - job.row)
+			rows = rowCount - job.row;
+		if (rows <= 0)
+			break;
+
+		std::memcpy(mapped + used, image.levels[job.level].data + job.row * rowBytes, rows * rowBytes);
+
+		// Compressed rows are 4 pixels tall; the last one may be cut short by the level's height
+		// 圧縮された行の高さは4ピクセル（最後の行はレベルの高さで短くなる場合がある）
+		int rowHeight = image.IsCompressed() ? 4 : 1;
+		int levelHeight = image.GetLevelHeight(job.level);
+
+		Band band;
+		band.texture = job.texture;
+		band.layer = job.layer;
+		band.level = job.level;
+		band.y = job.row * rowHeight;
+		band.width = image.GetLevelWidth(job.level);
+		band.height = (job.row + rows) * rowHeight < levelHeight ? rows * rowHeight : levelHeight - band.y;
+		band.internalFormat = image.internalFormat;
+		band.format = image.format;
+		band.offset = used;
+		band.size = rows * rowBytes;
+		band.pending = nullptr;
+		band.generateMipmap = false;
+
+		job.row += rows;
+		used += rows * rowBytes;
+
+		// Move on to the next mip level, or finish the texture
+		// 次のミップレベルに進むか、テクスチャを完成させる
+		if (job.row == rowCount)
+		{
+			job.level++;
+			job.row = 0;
+
+			if (job.level >= (int)image.levels.size())
+			{
+				band.pending = job.pending;
+				band.generateMipmap = image.generateMipmap;
+				jobs.pop_front();
+			}
+		}
+
+		bands.push_back(band);
+	}
+
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	// Upload the bands from the PBO; the offset stands in for the pixel pointer
+	// PBOから各帯を転送する（オフセットがピクセルポインタの代わりになる）
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (Band& band : bands)
+	{
+		GLenum target = band.layer >= 0 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+		const void* pixels = (const void*)band.offset;
+		GLState::BindTexture(target, band.texture);
+
+		// Compressed bands are copied as raw blocks, uncompressed ones converted by the driver as usual
+		// 圧縮された帯はブロックのままコピーされ、非圧縮の帯は通常どおりドライバが変換する
+		if (band.format == 0 && band.layer >= 0)
+			glCompressedTexSubImage3D(target, band.level, 0, band.y, band.layer, band.width, band.height, 1, band.internalFormat, (GLsizei)band.size, pixels);
+		else if (band.format == 0)
+			glCompressedTexSubImage2D(target, band.level, 0, band.y, band.width, band.height, band.internalFormat, (GLsizei)band.size, pixels);
+		else if (band.layer >= 0)
+			glTexSubImage3D(target, band.level, 0, band.y, band.layer, band.width, band.height, 1, band.format, GL_UNSIGNED_BYTE, pixels);
+		else
+			glTexSubImage2D(target, band.level, 0, band.y, band.width, band.height, band.format, GL_UNSIGNED_BYTE, pixels);
+
+		if (band.pending)
+		{
+			if (band.generateMipmap)
+				glGenerateMipmap(target);
+			(*band.pending)--;
+		}
+		GLState::BindTexture(target, 0);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	uploadedBytes += used;
+
+	// Remember when the GPU is done with this PBO, then move to the next one
+	// GPUがこのPBOを使い終える時点を記録し、次のPBOに進む
+	fences[next] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	next = (next + 1) % ringSize;
+}
\ No newline at end of file
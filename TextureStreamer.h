@@ -0,0 +1,109 @@
+#ifndef TEXTURE_STREAMER_CLASS_H
+#define TEXTURE_STREAMER_CLASS_H
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <glad/glad.h>
+#include "TextureImage.h"
+#include "Profiling.h"
+#include "GLHandle.h"
+
+// TextureStreamer class that uploads texture pixels through a ring of pixel buffer objects,
+// spending at most a fixed number of bytes per frame so loading never stalls a frame
+// ピクセルバッファオブジェクトのリングを通してテクスチャのピクセルを転送するTextureStreamerクラス
+// 1フレームあたり決まったバイト数までしか使わないため、読み込みでフレームが止まらない
+class TextureStreamer
+{
+public:
+
+	// Constructor that creates the PBO ring (call with a current GL context)
+	// PBOリングを作成するコンストラクタ（GLコンテキストが有効な状態で呼ぶ）
+	TextureStreamer(GLsizeiptr bytesPerFrame = 4 * 1024 * 1024, unsigned int ringSize = 3);
+
+	// Destructor that deletes the fences (the PBO handles delete themselves)
+	// フェンスを削除するデストラクタ（PBOはハンドルが自ら削除する）
+	~TextureStreamer();
+
+	// The streamer owns GL objects, so it cannot be copied
+	// ストリーマーはGLオブジェクトを所有するため、コピーできない
+	TextureStreamer(const TextureStreamer&) = delete;
+	TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+	// Queues the pixels of a texture whose storage is already allocated
+	// Every level of the image is uploaded in turn; with generateMipmap the rest of the chain is built on the GPU.
+	// pending is decremented once the texture is complete; owner keeps the pixels alive until then.
+	// A layer of 0 or more targets that layer of a GL_TEXTURE_2D_ARRAY instead of a GL_TEXTURE_2D.
+	// ストレージ確保済みのテクスチャのピクセルをキューに入れる
+	// 画像の各レベルを順に転送する（generateMipmapの場合、残りのチェーンはGPUで作成する）
+	// テクスチャが完成するとpendingが1減る。ownerはそれまでピクセルを保持する
+	// layerが0以上の場合、GL_TEXTURE_2DではなくGL_TEXTURE_2D_ARRAYのそのレイヤーが対象になる
+	void Queue
+	(
+		GLuint texture,
+		const TextureImage& image,
+		unsigned int* pending,
+		std::shared_ptr<const void> owner = nullptr,
+		GLint layer = -1
+	);
+
+	// Uploads queued pixels up to the per-frame budget (call once per frame)
+	// キュー内のピクセルを1フレームの予算まで転送する（毎フレーム1回呼ぶ）
+	void Update();
+
+	// Returns true if no texture is waiting to be uploaded
+	// 転送待ちのテクスチャが無ければtrueを返す
+	inline bool IsIdle() const { return jobs.empty(); }
+
+	// Returns the total number of bytes uploaded so far
+	// これまでに転送した総バイト数を返す
+	inline size_t GetUploadedBytes() const { return uploadedBytes; }
+
+	// Returns the memory of the PBO ring
+	// PBOリングのメモリ量を返す
+	inline MemoryUsage GetMemoryUsage() const
+	{
+		MemoryUsage usage;
+		usage.bufferBytes = (size_t)bytesPerFrame * ringSize;
+		return usage;
+	}
+
+private:
+
+	// Texture being uploaded, with how far it has got
+	// 転送中のテクスチャとその進み具合
+	struct Job
+	{
+		GLuint texture;
+		TextureImage image;
+		unsigned int* pending;
+		std::shared_ptr<const void> owner;
+		GLint layer;
+
+		// Current level and the next row to upload (rows of 4x4 blocks for compressed images)
+		// 現在のレベルと次に転送する行（圧縮画像の場合は4x4ブロックの行）
+		int level = 0;
+		int row = 0;
+	};
+
+	// Textures waiting to be uploaded, oldest first
+	// 転送待ちのテクスチャ（古い順）
+	std::deque<Job> jobs;
+
+	// Ring of pixel buffer objects and the fence of the last frame that used each one
+	// ピクセルバッファオブジェクトのリングと、それぞれを最後に使ったフレームのフェンス
+	std::vector<GLBuffer> pbos;
+	std::unique_ptr<GLsync[]> fences;
+	unsigned int ringSize;
+	unsigned int next = 0;
+
+	// Bytes that may be uploaded per frame (also the size of each PBO)
+	// 1フレームに転送できるバイト数（各PBOのサイズでもある）
+	GLsizeiptr bytesPerFrame;
+
+	// Total number of bytes uploaded
+	// 転送した総バイト数
+	size_t uploadedBytes = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef THREAD_POOL_CLASS_H
+#define THREAD_POOL_CLASS_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <future>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+
+// ThreadPool class that runs CPU-only tasks on a fixed set of worker threads
+// Tasks must not call OpenGL, since the context belongs to the main thread
+// CPUのみのタスクを固定数のワーカースレッドで実行するThreadPoolクラス
+// コンテキストはメインスレッドに属するため、タスクからOpenGLを呼んではならない
+class ThreadPool
+{
+public:
+
+	// Constructor that starts the workers (0 uses one per core, leaving one for the main thread)
+	// ワーカーを起動するコンストラクタ（0の場合はメインスレッド用に1つ残してコアごとに1つ）
+	ThreadPool(unsigned int threadCount = 0);
+
+	// Destructor that finishes the queued tasks and joins the workers
+	// キュー内のタスクを終えてワーカーを合流させるデストラクタ
+	~ThreadPool();
+
+	// Worker threads cannot be copied
+	// ワーカースレッドはコピーできない
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Queues a task and returns a future for its result (exceptions are rethrown by get)
+	// タスクをキューに入れ、結果のfutureを返す（例外はgetで再送出される）
+	template <typename F>
+	auto Submit(F task) -> std::future<decltype(task())>
+	{
+		auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+		std::future<decltype(task())> result = packaged->get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push([packaged]() { (*packaged)(); });
+		}
+		wake.notify_one();
+		return result;
+	}
+
+	// Returns the number of worker threads
+	// ワーカースレッドの数を返す
+	inline unsigned int GetThreadCount() const { return (unsigned int)workers.size(); }
+
+private:
+
+	// Worker threads
+	// ワーカースレッド
+	std::vector<std::thread> workers;
+
+	// Tasks waiting for a worker
+	// ワーカーを待っているタスク
+	std::queue<std::function<void()>> tasks;
+
+	// Guards tasks and stopping
+	// tasksとstoppingを保護する
+	std::mutex mutex;
+
+	// Wakes workers when a task is queued or the pool stops
+	// タスクが追加されたかプールが停止したときにワーカーを起こす
+	std::condition_variable wake;
+
+	// Set once the destructor runs
+	// デストラクタが実行されるとセットされる
+	bool stopping = false;
+
+	// Runs queued tasks until the pool stops
+	// プールが停止するまでキュー内のタスクを実行する
+	void workerLoop();
+};
+
+#endif
\ No newline at end of file
@@ -27,50 +27,49 @@ public:
 		m_scale(scale) {
 	}
 
-	// Returns the full model matrix (T * R * S)
-	// モデル行列（T * R * S）を返す
-	inline glm::mat4 GetModel() const
+	// Returns the full model matrix (T * R * S), rebuilt only after the position, rotation or scale changed
+	// モデル行列（T * R * S）を返す（位置・回転・スケールが変わった後にのみ作り直す）
+	inline const glm::mat4& GetModel() const
 	{
-		// Create translation matrix from position
-		// 位置から平行移動行列を作成する
-		glm::mat4 posMatrix = glm::translate(m_pos);
-
-		// Create scale matrix from scale vector
-		// スケールベクトルから拡大縮小行列を作成する
-		glm::mat4 scaleMatrix = glm::scale(m_scale);
-
-		// Convert quaternion rotation to matrix
-		// クォータニオン回転を行列に変換する
-		glm::mat4 rotMatrix = glm::mat4_cast(m_rot);
+		if (m_dirty)
+			update();
+		return m_model;
+	}
 
-		// Combine into final model matrix (Translate * Rotate * Scale)
-		// 最終的なモデル行列に結合する（平行移動 × 回転 × 拡大縮小）
-		return posMatrix * rotMatrix * scaleMatrix;
+	// Returns the inverse of the model matrix (S^-1 * R^T * T^-1), cached along with it
+	// Built from the parts instead of a general inverse, so the scale must not be 0 on any axis.
+	// モデル行列の逆行列（S^-1 * R^T * T^-1）を返す（モデル行列と一緒にキャッシュされる）
+	// 一般の逆行列ではなく各要素から作るため、どの軸のスケールも0であってはならない
+	inline const glm::mat4& GetInverseModel() const
+	{
+		if (m_dirty)
+			update();
+		return m_inverseModel;
 	}
 
-	// Returns reference to position vector
-	// 位置ベクトルへの参照を返す
-	inline glm::vec3& GetPos() { return m_pos; }
+	// Returns the position vector (change it with SetPos so the cached matrices follow)
+	// 位置ベクトルを返す（キャッシュされた行列が追従するよう、変更はSetPosで行う）
+	inline const glm::vec3& GetPos() const { return m_pos; }
 
-	// Returns reference to rotation quaternion
-	// 回転クォータニオンへの参照を返す
-	inline glm::quat& GetRot() { return m_rot; }
+	// Returns the rotation quaternion (change it with SetRot)
+	// 回転クォータニオンを返す（変更はSetRotで行う）
+	inline const glm::quat& GetRot() const { return m_rot; }
 
-	// Returns reference to scale vector
-	// スケールベクトルへの参照を返す
-	inline glm::vec3& GetScale() { return m_scale; }
+	// Returns the scale vector (change it with SetScale)
+	// スケールベクトルを返す（変更はSetScaleで行う）
+	inline const glm::vec3& GetScale() const { return m_scale; }
 
 	// Sets position
 	// 位置を設定する
-	inline void SetPos(const glm::vec3& pos) { m_pos = pos; }
+	inline void SetPos(const glm::vec3& pos) { m_pos = pos; m_dirty = true; }
 
 	// Sets rotation
 	// 回転を設定する
-	inline void SetRot(const glm::quat& rot) { m_rot = rot; }
+	inline void SetRot(const glm::quat& rot) { m_rot = rot; m_dirty = true; }
 
 	// Sets scale
 	// スケールを設定する
-	inline void SetScale(const glm::vec3& scale) { m_scale = scale; }
+	inline void SetScale(const glm::vec3& scale) { m_scale = scale; m_dirty = true; }
 
 protected:
 private:
@@ -87,6 +86,39 @@ private:
 	// 各軸方向のスケール係数
 	glm::vec3 m_scale;
 
+	// Model matrix and its inverse, valid while m_dirty is false (filled in lazily by the const getters)
+	// モデル行列とその逆行列（m_dirtyがfalseの間有効。constのゲッターが遅延して埋める）
+	mutable glm::mat4 m_model = glm::mat4(1.0f);
+	mutable glm::mat4 m_inverseModel = glm::mat4(1.0f);
+	mutable bool m_dirty = true;
+
+	// Rebuilds the model matrix and its inverse from the position, rotation and scale
+	// 位置・回転・スケールからモデル行列とその逆行列を作り直す
+	void update() const
+	{
+		// Combine into final model matrix (Translate * Rotate * Scale); scaling the rotation's columns
+		// is the same as multiplying by a scale matrix
+		// 最終的なモデル行列に結合する（平行移動 × 回転 × 拡大縮小。回転の各列を拡大縮小するのは
+		// 拡大縮小行列を掛けるのと同じ）
+		glm::mat3 rotation = glm::mat3_cast(m_rot);
+		m_model = glm::mat4(1.0f);
+		for (int i = 0; i < 3; i++)
+			m_model[i] = glm::vec4(rotation[i] * m_scale[i], 0.0f);
+		m_model[3] = glm::vec4(m_pos, 1.0f);
+
+		// The inverse of a rotation is its transpose, and the inverse of a scale is its reciprocal,
+		// so row i of the inverse's 3x3 is column i of the rotation divided by the scale on axis i
+		// 回転の逆は転置、拡大縮小の逆は逆数のため、逆行列の3x3のi行目は回転のi列目を軸iのスケールで割ったもの
+		glm::mat3 inverse = glm::transpose(rotation);
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				inverse[j][i] /= m_scale[i];
+		m_inverseModel = glm::mat4(inverse);
+		m_inverseModel[3] = glm::vec4(-(inverse * m_pos), 1.0f);
+
+		m_dirty = false;
+	}
+
 };
 
 #endif
\ No newline at end of file
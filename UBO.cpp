@@ -0,0 +1,40 @@
+#include "UBO.h"
+
+// Constructor: Generates a Uniform Buffer Object (UBO) and attaches it to its binding point
+// コンストラクタ：ユニフォームバッファオブジェクト（UBO）を生成し、バインディングポイントに結び付ける
+UBO::UBO(GLuint binding, GLsizeiptr size)
+	: binding(binding), size(size)
+{
+	ID = GLBuffer::Create();
+
+	// Allocate the block; its contents are uploaded later (GL_DYNAMIC_DRAW = changed often)
+	// ブロックを確保する（内容は後で転送する。GL_DYNAMIC_DRAW = 頻繁に変更する）
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, ID);
+	glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	Bind();
+}
+
+// Uploads the whole block
+// ブロック全体を転送する
+void UBO::Upload(const void* data)
+{
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, ID);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// Bind this UBO to its indexed binding point
+// このUBOをインデックス付きのバインディングポイントにバインドする
+void UBO::Bind()
+{
+	GLState::BindUniformBuffer(binding, ID);
+}
+
+// Delete the UBO and free GPU memory
+// GPUメモリからUBOを削除する
+void UBO::Delete()
+{
+	ID.Reset();
+}
\ No newline at end of file
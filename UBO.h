@@ -0,0 +1,106 @@
+#ifndef UBO_CLASS_H
+#define UBO_CLASS_H
+
+#include<glm/glm.hpp>
+#include<glad/glad.h>
+#include"GLHandle.h"
+
+// Binding points of the uniform blocks every shader shares; Shader binds blocks with these names to them after linking
+// すべてのシェーダーが共有するuniformブロックのバインディングポイント（Shaderはリンク後、これらの名前のブロックをここに結び付ける）
+enum UniformBlockBinding : GLuint
+{
+	FRAME_BLOCK_BINDING = 0,
+	LIGHTS_BLOCK_BINDING = 1,
+	MATERIAL_BLOCK_BINDING = 2,
+	UNIFORM_BLOCK_COUNT = 3
+};
+
+// Block names as declared in the shaders, by binding point
+// シェーダー内で宣言されたブロック名（バインディングポイント順）
+static const char* const UNIFORM_BLOCK_NAMES[UNIFORM_BLOCK_COUNT] = { "Frame", "Lights", "Material" };
+
+// The structs below mirror the std140 blocks of default.vert and default.frag member for member
+// (a vec3 followed by a float shares one 16-byte slot, so no padding is needed between them)
+// 以下の構造体は、default.vertとdefault.fragのstd140ブロックとメンバーごとに一致する
+// （vec3の後のfloatは同じ16バイトの枠に入るため、間に詰め物は不要）
+
+// Constants of one frame, uploaded once per frame
+// 1フレームの定数（毎フレーム1回転送する）
+struct FrameBlock
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+
+	// Projection times view
+	// 投影×ビュー
+	glm::mat4 viewProjection;
+
+	glm::vec3 cameraPosition;
+
+	// Seconds since the program started
+	// プログラム開始からの秒数
+	float time;
+};
+
+// The scene's point light, uploaded whenever it changes
+// シーンの点光源（変更されたときに転送する）
+struct LightsBlock
+{
+	glm::vec4 color;
+	glm::vec3 position;
+	float padding;
+};
+
+// Shading parameters of a material; a model with a material of its own binds its buffer before drawing
+// マテリアルのシェーディングパラメータ（独自のマテリアルを持つモデルは描画前にそのバッファをバインドする）
+struct MaterialBlock
+{
+	// Ambient term, specular strength and specular exponent
+	// 環境光の項・鏡面反射の強さ・鏡面反射の指数
+	float ambient = 0.20f;
+	float specular = 0.50f;
+	float shininess = 16.0f;
+	float padding = 0.0f;
+};
+
+static_assert(sizeof(FrameBlock) == 208, "FrameBlock must match the std140 layout of the Frame block");
+static_assert(sizeof(LightsBlock) == 32, "LightsBlock must match the std140 layout of the Lights block");
+static_assert(sizeof(MaterialBlock) == 16, "MaterialBlock must match the std140 layout of the Material block");
+
+// Uniform Buffer Object (UBO) class
+// ユニフォームバッファオブジェクト（UBO）クラス
+// Holds one uniform block that every shader declaring it reads from its binding point
+// ブロックを宣言するすべてのシェーダーがバインディングポイントから読み取る、1つのuniformブロックを保持する
+class UBO
+{
+public:
+
+	// OpenGL buffer, deleted with the UBO (so UBOs can be moved but not copied)
+	// OpenGLバッファ（UBOと共に削除されるため、UBOはムーブできるがコピーできない）
+	GLBuffer ID;
+
+	// Binding point and size in bytes of the block
+	// ブロックのバインディングポイントとバイト数
+	GLuint binding;
+	GLsizeiptr size;
+
+	// Constructor:
+	// Generates a UBO of size bytes and binds it to the binding point
+	// コンストラクタ：
+	// sizeバイトのUBOを生成し、バインディングポイントにバインドする
+	UBO(GLuint binding, GLsizeiptr size);
+
+	// Replaces the whole block with size bytes from data
+	// ブロック全体をdataからのsizeバイトで置き換える
+	void Upload(const void* data);
+
+	// Binds this UBO to its binding point (e.g. after another material's buffer was bound there)
+	// このUBOをバインディングポイントにバインドする（例：別のマテリアルのバッファがバインドされた後）
+	void Bind();
+
+	// Delete the UBO and free GPU memory
+	// UBOを削除し、GPUメモリを解放する
+	void Delete();
+};
+
+#endif
\ No newline at end of file
@@ -6,7 +6,7 @@ VAO::VAO()
 {
 	// Generate one VAO and store its ID
 	// VAOを1つ生成し、そのIDを取得する
-	glGenVertexArrays(1, &ID);
+	ID = GLVertexArray::Create();
 }
 
 // Links a VBO attribute to this VAO
@@ -14,7 +14,7 @@ VAO::VAO()
 //
 // VBOの属性をこのVAOに関連付ける
 // 頂点データのレイアウトをシェーダーの属性ロケーションに設定する
-void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset)
+void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset, GLboolean normalized)
 {
 	// Bind the VBO before defining attribute pointer
 	// 属性ポインタを設定する前にVBOをバインドする
@@ -39,7 +39,7 @@ void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type,
 	// 4. 正規化するかどうか
 	// 5. ストライド（頂点間のバイト間隔）
 	// 6. オフセット（構造体内の開始位置）
-	glVertexAttribPointer(layout, numComponents, type, GL_FALSE, stride, offset);
+	glVertexAttribPointer(layout, numComponents, type, normalized, stride, offset);
 
 	// Enable the vertex attribute so the shader can access it
 	// シェーダーから使用できるように頂点属性を有効化する
@@ -50,23 +50,34 @@ void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type,
 	VBO.Unbind();
 }
 
+// Links each attribute described by the layout
+// レイアウトに記述された各属性をリンクする
+void VAO::LinkLayout(VBO& VBO, const VertexLayout& layout)
+{
+	for (unsigned int i = 0; i < layout.attributeCount; i++)
+	{
+		const VertexAttribute& attribute = layout.attributes[i];
+		LinkAttrib(VBO, attribute.location, attribute.components, attribute.type, layout.stride, (void*)(uintptr_t)attribute.offset, attribute.normalized);
+	}
+}
+
 // Bind this VAO as the active vertex array object
 // このVAOをアクティブな頂点配列オブジェクトとしてバインドする
 void VAO::Bind()
 {
-	glBindVertexArray(ID);
+	GLState::BindVertexArray(ID);
 }
 
 // Unbind any currently bound VAO
 // 現在バインドされているVAOを解除する
 void VAO::Unbind()
 {
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 }
 
 // Delete the VAO from GPU memory
 // GPUメモリからVAOを削除する
 void VAO::Delete()
 {
-	glDeleteVertexArrays(1, &ID);
+	ID.Reset();
 }
\ No newline at end of file
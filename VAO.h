@@ -3,6 +3,7 @@
 
 #include<glad/glad.h>
 #include "VBO.h"
+#include "GLHandle.h"
 
 // Vertex Array Object (VAO) class
 // 頂点配列オブジェクト（VAO）クラス
@@ -10,9 +11,9 @@ class VAO
 {
 public:
 
-	// OpenGL VAO identifier
-	// OpenGLのVAO識別ID
-	GLuint ID;
+	// OpenGL vertex array, deleted with the VAO (so VAOs can be moved but not copied)
+	// OpenGLの頂点配列（VAOと共に削除されるため、VAOはムーブできるがコピーできない）
+	GLVertexArray ID;
 
 	// Constructor:
 	// Generates a new VAO
@@ -29,6 +30,7 @@ public:
 	// - type: Data type (e.g., GL_FLOAT)
 	// - stride: Byte offset between consecutive vertices
 	// - offset: Starting offset within the vertex structure
+	// - normalized: Whether integer data is mapped to [-1, 1] / [0, 1]
 	//
 	// VBOの頂点属性をこのVAOに関連付ける
 	//
@@ -39,7 +41,12 @@ public:
 	// - type: データ型（例：GL_FLOAT）
 	// - stride: 頂点間のバイト間隔
 	// - offset: 構造体内の開始位置
-	void LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset);
+	// - normalized: 整数データを[-1, 1] / [0, 1]に変換するかどうか
+	void LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset, GLboolean normalized = GL_FALSE);
+
+	// Links every attribute of a vertex layout (e.g. VertexTraits<Vertex>::layout) to this VAO
+	// 頂点レイアウト（例：VertexTraits<Vertex>::layout）のすべての属性をこのVAOに関連付ける
+	void LinkLayout(VBO& VBO, const VertexLayout& layout);
 
 	// Bind this VAO as the active vertex array
 	// このVAOをアクティブな頂点配列としてバインドする
@@ -4,28 +4,8 @@
 #include<glm/glm.hpp>
 #include<glad/glad.h>
 #include<vector>
-
-// Structure representing a single vertex
-// 1つの頂点を表す構造体
-struct Vertex
-{
-	// Position of the vertex in 3D space
-	// 頂点の3次元空間での位置
-	glm::vec3 position;
-
-	// Normal vector (used for lighting calculations)
-	// 法線ベクトル（ライティング計算に使用）
-	glm::vec3 normal;
-
-	// Vertex color
-	// 頂点カラー
-	glm::vec3 color;
-
-	// Texture coordinates (UV mapping)
-	// テクスチャ座標（UVマッピング）
-	glm::vec2 texUV;
-};
-
+#include"VertexLayout.h"
+#include"GLHandle.h"
 
 // Vertex Buffer Object (VBO) class
 // GPUに頂点データを保存するための頂点バッファオブジェクトクラス
@@ -33,9 +13,9 @@ class VBO
 {
 public:
 
-	// OpenGL buffer ID
-	// OpenGLバッファの識別ID
-	GLuint ID;
+	// OpenGL buffer, deleted with the VBO (so VBOs can be moved but not copied)
+	// OpenGLバッファ（VBOと共に削除されるため、VBOはムーブできるがコピーできない）
+	GLBuffer ID;
 
 	// Constructor:
 	// Generates a VBO and uploads vertex data to GPU memory
@@ -43,6 +23,10 @@ public:
 	// VBOを生成し、頂点データをGPUメモリに転送する
 	VBO(std::vector<Vertex>& vertices);
 
+	// Constructor that uploads size bytes of vertices of any layout straight from memory (e.g. a mapped card pack)
+	// 任意のレイアウトの頂点sizeバイトをメモリ（例：マッピングされたカードパック）から直接転送するコンストラクタ
+	VBO(const void* vertices, GLsizeiptr size);
+
 	// Bind this VBO as the active GL_ARRAY_BUFFER
 	// このVBOをGL_ARRAY_BUFFERとしてバインドする
 	void Bind();
@@ -0,0 +1,80 @@
+#include "VertexLayout.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <glm/gtc/packing.hpp>
+
+const VertexLayout& get_vertex_layout(uint32_t format)
+{
+	switch (format)
+	{
+	case VERTEX_FORMAT_FLOAT:
+		return VertexTraits<Vertex>::layout;
+	case VERTEX_FORMAT_PACKED:
+		return VertexTraits<PackedVertex>::layout;
+	default:
+		throw std::invalid_argument("Unknown vertex format");
+	}
+}
+
+bool can_pack_vertices(const std::vector<Vertex>& vertices)
+{
+	if (vertices.empty())
+		return false;
+
+	// Size of the mesh, which sets how much position error is invisible
+	// 見えない位置の誤差の大きさを決めるメッシュの大きさ
+	glm::vec3 lower = vertices[0].position;
+	glm::vec3 upper = vertices[0].position;
+	for (const Vertex& vertex : vertices)
+	{
+		lower = glm::min(lower, vertex.position);
+		upper = glm::max(upper, vertex.position);
+	}
+	glm::vec3 extent = upper - lower;
+	float tolerance = std::fmax(extent.x, std::fmax(extent.y, extent.z)) / 4096.0f;
+
+	for (const Vertex& vertex : vertices)
+	{
+		// Normalized 16-bit UVs cannot repeat a texture
+		// 正規化16ビットのUVではテクスチャを繰り返せない
+		if (vertex.texUV.x < 0.0f || vertex.texUV.x > 1.0f || vertex.texUV.y < 0.0f || vertex.texUV.y > 1.0f)
+			return false;
+
+		// Half floats lose precision far from the origin, so a mesh placed far away keeps full floats
+		// 半精度は原点から離れると精度が落ちるため、遠くに置かれたメッシュは通常の浮動小数点のままにする
+		for (int i = 0; i < 3; i++)
+		{
+			float packed = glm::unpackHalf1x16(glm::packHalf1x16(vertex.position[i]));
+			if (!(std::fabs(packed - vertex.position[i]) <= tolerance))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+std::vector<PackedVertex> pack_vertices(const std::vector<Vertex>& vertices)
+{
+	std::vector<PackedVertex> packed(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const Vertex& vertex = vertices[i];
+
+		packed[i].position[0] = glm::packHalf1x16(vertex.position.x);
+		packed[i].position[1] = glm::packHalf1x16(vertex.position.y);
+		packed[i].position[2] = glm::packHalf1x16(vertex.position.z);
+		packed[i].position[3] = 0;
+
+		// Normals are renormalized so rounding cannot push them past unit length; the 2-bit w is unused by the shader
+		// 丸めで単位長を超えないよう法線は正規化し直す（2ビットのwはシェーダーでは使わない）
+		glm::vec3 normal = glm::length(vertex.normal) > 0.0f ? glm::normalize(vertex.normal) : vertex.normal;
+		packed[i].normal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+
+		packed[i].texUV[0] = (uint16_t)std::lround(vertex.texUV.x * 65535.0f);
+		packed[i].texUV[1] = (uint16_t)std::lround(vertex.texUV.y * 65535.0f);
+	}
+
+	return packed;
+}
\ No newline at end of file
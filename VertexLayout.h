@@ -0,0 +1,129 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+
+// One vertex attribute as glVertexAttribPointer sees it
+// glVertexAttribPointerから見た1つの頂点属性
+struct VertexAttribute
+{
+	// Location in the shader, number of components, GL type and whether integers are normalized to [-1, 1] / [0, 1]
+	// シェーダー内のロケーション・要素数・GLの型・整数を[-1, 1] / [0, 1]に正規化するかどうか
+	GLuint location;
+	GLint components;
+	GLenum type;
+	GLboolean normalized;
+
+	// Byte offset inside the vertex
+	// 頂点内のバイトオフセット
+	GLuint offset;
+};
+
+// Layout of one vertex type: its stride and attributes, used by VAO::LinkLayout
+// 1つの頂点型のレイアウト（ストライドと属性。VAO::LinkLayoutで使う）
+struct VertexLayout
+{
+	static constexpr unsigned int MAX_ATTRIBUTES = 4;
+
+	GLsizei stride;
+	unsigned int attributeCount;
+	VertexAttribute attributes[MAX_ATTRIBUTES];
+};
+
+// Compile-time layout of a vertex type, specialized next to each type below
+// 頂点型のコンパイル時レイアウト（下記の各型の隣で特殊化する）
+template <typename V>
+struct VertexTraits;
+
+// Vertex formats a mesh can be stored in (also written to card packs)
+// メッシュを格納できる頂点フォーマット（カードパックにも書き込まれる）
+enum VertexFormat : uint32_t
+{
+	VERTEX_FORMAT_FLOAT = 0,
+	VERTEX_FORMAT_PACKED = 1
+};
+
+// Structure representing a single vertex, with every attribute as 32-bit floats
+// すべての属性を32ビット浮動小数点で持つ、1つの頂点を表す構造体
+struct Vertex
+{
+	// Position of the vertex in 3D space
+	// 頂点の3次元空間での位置
+	glm::vec3 position;
+
+	// Normal vector (used for lighting calculations)
+	// 法線ベクトル（ライティング計算に使用）
+	glm::vec3 normal;
+
+	// Texture coordinates (UV mapping)
+	// テクスチャ座標（UVマッピング）
+	glm::vec2 texUV;
+};
+
+template <>
+struct VertexTraits<Vertex>
+{
+	static constexpr VertexLayout layout =
+	{
+		sizeof(Vertex), 3,
+		{
+			{ 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position) },
+			{ 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal) },
+			{ 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texUV) }
+		}
+	};
+};
+
+// Compact vertex: 16 bytes instead of 32, unpacked by the vertex fetch hardware so the shader is unchanged
+// コンパクトな頂点（32バイトではなく16バイト。頂点フェッチのハードウェアが展開するためシェーダーは変わらない）
+struct PackedVertex
+{
+	// Position as half floats (the fourth is padding that keeps the normal 4-byte aligned)
+	// 半精度浮動小数点の位置（4つ目は法線を4バイト境界に揃えるためのパディング）
+	uint16_t position[4];
+
+	// Normal as signed normalized 10:10:10:2 (GL_INT_2_10_10_10_REV)
+	// 符号付き正規化10:10:10:2の法線（GL_INT_2_10_10_10_REV）
+	uint32_t normal;
+
+	// Texture coordinates as unsigned normalized 16-bit integers
+	// 符号なし正規化16ビット整数のテクスチャ座標
+	uint16_t texUV[2];
+};
+
+template <>
+struct VertexTraits<PackedVertex>
+{
+	static constexpr VertexLayout layout =
+	{
+		sizeof(PackedVertex), 3,
+		{
+			{ 0, 3, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedVertex, position) },
+			{ 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(PackedVertex, normal) },
+			{ 2, 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedVertex, texUV) }
+		}
+	};
+};
+
+static_assert(sizeof(Vertex) == 32, "Vertex must match the layout stored in card packs");
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must match the layout stored in card packs");
+
+// Returns the layout of a vertex format; throws std::invalid_argument for an unknown format
+// 頂点フォーマットのレイアウトを返す（未知のフォーマットの場合はstd::invalid_argumentを投げる）
+const VertexLayout& get_vertex_layout(uint32_t format);
+
+// Returns true if the vertices survive packing: UVs must lie in [0, 1] and half-float positions
+// must stay within 1/4096 of the mesh's size
+// 頂点がパックに耐えられればtrueを返す（UVは[0, 1]内にあり、半精度の位置の誤差が
+// メッシュの大きさの1/4096以内に収まらなければならない）
+bool can_pack_vertices(const std::vector<Vertex>& vertices);
+
+// Converts vertices to the packed format
+// 頂点をパック形式に変換する
+std::vector<PackedVertex> pack_vertices(const std::vector<Vertex>& vertices);
+
+#endif
\ No newline at end of file
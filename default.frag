@@ -6,22 +6,56 @@ out vec4 FragColor;
 in vec3 currentPos;
 // Imports the normal from the Vertex Shader
 in vec3 Normal;
-// Imports the color from the Vertex Shader
-in vec3 color;
 // Imports the texture coordinates from the Vertex Shader
 in vec2 texCoord;
 
-
-
-
 uniform sampler2D diffuse0;
 uniform sampler2D specular0;
 
-uniform vec4 lightColor;
+// Card faces shared by the whole board, and the layer of this model from the Vertex Shader (-1 uses diffuse0)
+uniform sampler2DArray faces;
+flat in int layer;
 
-uniform vec3 lightPos;
+// Constants of the frame, shared by every shader (std140, mirrored by FrameBlock in UBO.h)
+layout (std140) uniform Frame
+{
+   mat4 view;
+   mat4 projection;
+   mat4 camMatrix;
+   vec3 cameraPos;
+   float time;
+};
+
+// The point light (mirrored by LightsBlock)
+layout (std140) uniform Lights
+{
+   vec4 lightColor;
+   vec3 lightPos;
+};
 
-uniform vec3 cameraPos;
+// Shading parameters of the material being drawn (mirrored by MaterialBlock)
+layout (std140) uniform Material
+{
+   float ambient;
+   float specularLight;
+   float shininess;
+};
+
+vec4 baseColor()
+{
+   if (layer >= 0)
+      return texture(faces, vec3(texCoord, layer));
+   return texture(diffuse0, texCoord);
+}
+
+// Specular intensity; a card drawn from the face array has no specular map and uses the red of its face,
+// like a model without one does (BindTextures points specular0 at its diffuse texture)
+float specularMap()
+{
+   if (layer >= 0)
+      return texture(faces, vec3(texCoord, layer)).r;
+   return texture(specular0, texCoord).r;
+}
 
 vec4 pointLight()
 {
@@ -31,37 +65,31 @@ vec4 pointLight()
    float b = 0.04;
    float inten = 5.0f / (a * dist * dist + b * dist + 1.0f);
 
-   float ambient = 0.20f;
-
    vec3 normal = normalize(Normal);
    vec3 lightDirection = normalize(lightVec);
    float diffuse = max(dot(normal, lightDirection), 0.0f);
 
-   float specularLight = 0.50f;
    vec3 viewDirection = normalize(cameraPos - currentPos);
    vec3 reflectionDirection = reflect(-lightDirection, normal);
-   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), 16);
+   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), shininess);
    float specular = specularAmount * specularLight;
 
-   return (texture(diffuse0, texCoord) * (diffuse * inten + ambient) + texture(specular0, texCoord).r * specular * inten) * lightColor;
+   return (baseColor() * (diffuse * inten + ambient) + specularMap() * specular * inten) * lightColor;
 }
 
 vec4 directLight()
 {
-   float ambient = 0.20f;
-
    vec3 normal = normalize(Normal);
    // Should come from the opposite direction you want the light to come from
    vec3 lightDirection = normalize(vec3(1.0f, 1.0f, 0.0f));
    float diffuse = max(dot(normal, lightDirection), 0.0f);
 
-   float specularLight = 0.50f;
    vec3 viewDirection = normalize(cameraPos - currentPos);
    vec3 reflectionDirection = reflect(-lightDirection, normal);
-   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), 16);
+   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), shininess);
    float specular = specularAmount * specularLight;
 
-   return (texture(diffuse0, texCoord) * (diffuse + ambient) + texture(specular0, texCoord).r * specular) * lightColor;
+   return (baseColor() * (diffuse + ambient) + specularMap() * specular) * lightColor;
 }
 
 vec4 spotLight()
@@ -69,22 +97,19 @@ vec4 spotLight()
    float outerCone = 0.90f;
    float innerCone = 0.95f;
 
-   float ambient = 0.20f;
-
    vec3 normal = normalize(Normal);
    vec3 lightDirection = normalize(lightPos - currentPos);
    float diffuse = max(dot(normal, lightDirection), 0.0f);
 
-   float specularLight = 0.50f;
    vec3 viewDirection = normalize(cameraPos - currentPos);
    vec3 reflectionDirection = reflect(-lightDirection, normal);
-   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), 16);
+   float specularAmount = pow(max(dot(viewDirection, reflectionDirection), 0.0f), shininess);
    float specular = specularAmount * specularLight;
 
    float angle = dot(vec3(0.0f, -1.0f, 0.0f), -lightDirection);
    float inten = clamp((angle - outerCone) / (innerCone - outerCone), 0.0f, 1.0f);
 
-   return (texture(diffuse0, texCoord) * (diffuse * inten + ambient) + texture(specular0, texCoord).r * specular * inten) * lightColor;
+   return (baseColor() * (diffuse * inten + ambient) + specularMap() * specular * inten) * lightColor;
 }
 
 void main()
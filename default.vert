@@ -4,39 +4,42 @@
 layout (location = 0) in vec3 aPos;
 // Normals
 layout (location = 1) in vec3 aNormal;
-// Colors
-layout (location = 2) in vec3 aColor;
 // Textures
-layout (location = 3) in vec2 aTex;
+layout (location = 2) in vec2 aTex;
+// Per-instance world matrix (locations 3-6), normal matrix (7-9) and face layer (10)
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat3 aNormalMatrix;
+layout (location = 10) in float aFaceLayer;
 
 
 // Outputs the current position for the Fragment Shader
 out vec3 currentPos;
 // Outputs the normal for the Fragment Shader
 out vec3 Normal;
-// Outputs the color for the Fragment Shader
-out vec3 color;
 // Outputs the texture coordinates to the Fragment Shader
 out vec2 texCoord;
+// Outputs the face layer to sample (-1 uses diffuse0)
+flat out int layer;
 
-// The Camera Matrix
-uniform mat4 camMatrix;
-uniform mat4 model;
-uniform mat4 translation;
-uniform mat4 rotation;
-uniform mat4 scale;
-
-uniform mat4 transform;
+// Constants of the frame, shared by every shader (std140, mirrored by FrameBlock in UBO.h)
+layout (std140) uniform Frame
+{
+   mat4 view;
+   mat4 projection;
+   // The Camera Matrix
+   mat4 camMatrix;
+   vec3 cameraPos;
+   float time;
+};
 
 void main()
 {
+   // Instances carry their own matrices, both built once per instance on the CPU, and their face layer
+   layer = int(aFaceLayer);
    // Calculates current position
-   currentPos = vec3(transform * model * translation * -rotation * scale * vec4(aPos, 1.0f));
+   currentPos = vec3(aModel * vec4(aPos, 1.0f));
    // Assigns the normal from the Vertex Data to "Normal" 
-   mat3 normalMatrix = transpose(inverse(mat3(transform * model * translation * -rotation * scale)));
-   Normal = normalize(normalMatrix * aNormal);
-   // Assigns the colors from the Vertex Data to "color"
-   color = aColor;
+   Normal = normalize(aNormalMatrix * aNormal);
    // Assigns the texture coordinates from the Vertex Data to "texCoord"
    texCoord = mat2(0.0, -1.0, 1.0, 0.0) * aTex;
    
@@ -1,5 +1,6 @@
 #include "MousePicker.h"
 #include "GameLogic.h"
+#include "UBO.h"
 
 
 
@@ -11,6 +12,12 @@ void processInput(GLFWwindow* window);
 
 int main()
 {
+	// Flip decoded images vertically to match OpenGL's coordinate system; the flag is global in stb_image,
+	// so it is set once here, before any worker thread starts decoding
+	// OpenGLの座標系に合わせてデコードした画像を上下反転する（stb_imageではこのフラグはグローバルなため、
+	// ワーカースレッドがデコードを始める前にここで一度だけ設定する）
+	stbi_set_flip_vertically_on_load(true);
+
 	// glfw: initialize and configure
 	// glfwを初期化します
 	// -------------------------------------------------------------------------------
@@ -75,10 +82,6 @@ int main()
 	glm::mat4 lightModel = glm::mat4(1.0f);
 	lightModel = glm::translate(lightModel, lightPos);
 
-	shaderProgram.Activate();
-	glUniform4f(glGetUniformLocation(shaderProgram.ID, "lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-	glUniform3f(glGetUniformLocation(shaderProgram.ID, "lightPos"), lightPos.x, lightPos.y, lightPos.z);
-
 	// Enable depth test
 	// デプス・テストを有効にする
 	glEnable(GL_DEPTH_TEST);
@@ -96,67 +99,145 @@ int main()
 		"models/sharkcard/SharkSimplePlayingCard.gltf"
 	};
 
-	// Make the board
-	// ボードを作る
-	Board board(cardModels);
-
-	// Make deltaTime for loop
-	// ループのdeltaTimeを設定する
-	float deltaTime = 0.0f;
-	float lastFrame = 0.0f;
-
-	// Create the MousePicker, MousePicker performs ray casting
-	// MousePickerを作成するMousePickerはレイキャスティングを実行する
-	MousePicker picker(camera);
-
-	// Create the GameLogic class that handles game logic
-	// ゲームロジックを処理するGameLogicクラスを作成する
-	GameLogic game(board, picker, camera);
-
-	// render loop
-	// レンダリングループ
-	// -------------------------------------------------------------------------------
-	// loops until user closes the window
-	// ユーザーがウィンドウを閉じるまでループする
-	while (!glfwWindowShouldClose(window)) 
+	// Scope the game objects so their GPU resources are freed while the context is still alive
+	// GPUリソースがコンテキストの生存中に解放されるよう、ゲームオブジェクトをスコープで囲む
 	{
-
-		// Input
-		processInput(window);
-
-
-		// Specify the colour of the background to Navy Blue
-		// 背景色をネイビーブルーに指定してください
-		glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
-		// Clean the back buffer and assign the new color to it
-		// バックバッファをクリアし、新しい色を割り当てる
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// Track the camera movement inputs
-		// カメラの動きの入力を追跡する
-		camera.Inputs(window);
-		camera.updateMatrix(45.0f, 0.1f, 100.0f);
-
-		float currentFrame = glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;
-
-		// Update the raycaster
-		// レイキャスターを更新する
-		picker.Update(window);
-
-		// Update the game logic
-		// ゲームロジックを更新する
-		game.Update(shaderProgram, deltaTime, window);
-
-		// Swap back buffer with front buffer
-		// バックバッファとフロントバッファを入れ替える
-		glfwSwapBuffers(window);
-
-		// check if any poll events (window appearing, being resized, etc) in GLFW are triggered
-		// GLFWで発生するポールのイベント（ウィンドウの表示、サイズ変更など）がトリガーされたかどうかを確認する
-		glfwPollEvents();
+		// Make the uniform buffers every shader reads the frame, light and material constants from
+		// すべてのシェーダーがフレーム・光源・マテリアルの定数を読み取るuniformバッファを作る
+		UBO frameBlock(FRAME_BLOCK_BINDING, sizeof(FrameBlock));
+		UBO lightsBlock(LIGHTS_BLOCK_BINDING, sizeof(LightsBlock));
+		UBO materialBlock(MATERIAL_BLOCK_BINDING, sizeof(MaterialBlock));
+
+		// The light and the cards' material never change, so they are uploaded once
+		// 光源とカードのマテリアルは変わらないため、一度だけ転送する
+		LightsBlock lights;
+		lights.color = lightColor;
+		lights.position = lightPos;
+		lights.padding = 0.0f;
+		lightsBlock.Upload(&lights);
+
+		MaterialBlock material;
+		materialBlock.Upload(&material);
+
+		// Make the model cache so each card design is loaded only once
+		// 各カードデザインを一度だけ読み込むためのモデルキャッシュを作る
+		ModelCache modelCache;
+
+		// Load cooked cards from the card pack if cardcook has produced one
+		// cardcookがカードパックを作成していれば、調理済みのカードをそこから読み込む
+		modelCache.Mount("cards.pak");
+
+		// Make the board
+		// ボードを作る
+		Board board(modelCache, cardModels);
+
+		// Report how many times each model was decoded, and where the memory went
+		// 各モデルが何回デコードされたか、メモリがどこで使われたかを報告する
+		modelCache.PrintStats();
+		modelCache.PrintMemory();
+		bool memoryKeyDown = false;
+		bool statsKeyDown = false;
+
+		// Make deltaTime for loop
+		// ループのdeltaTimeを設定する
+		float deltaTime = 0.0f;
+		float lastFrame = 0.0f;
+
+		// Create the MousePicker, MousePicker performs ray casting
+		// MousePickerを作成するMousePickerはレイキャスティングを実行する
+		MousePicker picker(camera);
+
+		// Create the GameLogic class that handles game logic
+		// ゲームロジックを処理するGameLogicクラスを作成する
+		GameLogic game(board, picker, camera);
+
+		// render loop
+		// レンダリングループ
+		// -------------------------------------------------------------------------------
+		// loops until user closes the window
+		// ユーザーがウィンドウを閉じるまでループする
+		while (!glfwWindowShouldClose(window)) 
+		{
+
+			// Input
+			processInput(window);
+
+
+			// Specify the colour of the background to Navy Blue
+			// 背景色をネイビーブルーに指定してください
+			glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
+			// Clean the back buffer and assign the new color to it
+			// バックバッファをクリアし、新しい色を割り当てる
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// Track the camera movement inputs
+			// カメラの動きの入力を追跡する
+			camera.Inputs(window);
+			camera.updateMatrix(45.0f, 0.1f, 100.0f);
+
+			float currentFrame = glfwGetTime();
+			deltaTime = currentFrame - lastFrame;
+			lastFrame = currentFrame;
+
+			// Upload the frame's constants once for every draw
+			// フレームの定数をすべての描画のために一度だけ転送する
+			FrameBlock frame;
+			frame.view = camera.viewMatrix;
+			frame.projection = camera.projectionMatrix;
+			frame.viewProjection = camera.cameraMatrix;
+			frame.cameraPosition = camera.cameraPosition;
+			frame.time = currentFrame;
+			frameBlock.Upload(&frame);
+
+			// Upload streamed models and texture rows within this frame's budget
+			// このフレームの予算内で、ストリーミング中のモデルとテクスチャの行を転送する
+			modelCache.Update();
+
+			// Print the memory report when M is pressed (once per press)
+			// Mが押されたらメモリ報告を出力する（1回押すごとに1回）
+			bool memoryKey = glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS;
+			if (memoryKey && !memoryKeyDown)
+				modelCache.PrintMemory();
+			memoryKeyDown = memoryKey;
+
+			// Print the last frame's draw calls and GL state calls when P is pressed
+			// Pが押されたら直前のフレームの描画呼び出しとGL状態の呼び出しを出力する
+			bool statsKey = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+			if (statsKey && !statsKeyDown)
+			{
+				GLState::Counters state = GLState::GetFrameCounters();
+				std::cout << "Frame: " << game.GetCuller().GetVisibleCount() << " cards visible, " << game.GetCuller().GetCulledCount() << " culled, "
+					<< game.GetRenderQueue().GetDrawCallCount() << " draw calls, " << game.GetRenderQueue().GetInstanceCount()
+					<< " instances, " << state.issued << " state calls issued, " << state.skipped << " skipped" << std::endl;
+			}
+			statsKeyDown = statsKey;
+
+			// Update the raycaster
+			// レイキャスターを更新する
+			picker.Update(window);
+
+			// Bind every card face once for the whole board
+			// ボード全体のためにすべてのカードの表面を一度だけバインドする
+			modelCache.GetTextureResidency().Bind(shaderProgram);
+
+			// Update the game logic
+			// ゲームロジックを更新する
+			game.Update(shaderProgram, deltaTime, window);
+
+			// Swap back buffer with front buffer
+			// バックバッファとフロントバッファを入れ替える
+			glfwSwapBuffers(window);
+
+			// Close this frame's count of issued and skipped state calls
+			// このフレームの発行・省略した状態の呼び出しの計数を締める
+			GLState::EndFrame();
+
+			// check if any poll events (window appearing, being resized, etc) in GLFW are triggered
+			// GLFWで発生するポールのイベント（ウィンドウの表示、サイズ変更など）がトリガーされたかどうかを確認する
+			glfwPollEvents();
+		}
 	}
+
 	// Delete the shader program after use
 	// 使用後にシェーダープログラムを削除する
 	shaderProgram.Delete();
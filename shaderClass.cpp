@@ -1,4 +1,8 @@
 #include "shaderClass.h"
+#include "UBO.h"
+
+#include <vector>
+#include <cstring>
 
 // Reads a text file and outputs a string with everything in the text file
 // テキストファイルを読み込み、その内容をすべて文字列として返す
@@ -79,7 +83,7 @@ Shader::Shader(const char* vertexFile, const char* fragmentFile)
 
 	// Create a shader program object which is the final linked version of multiple shaders combined
 	// 複数のシェーダーを結合した最終的なリンク済みプログラムオブジェクトを作成する
-	ID = glCreateProgram();
+	ID = GLProgram::Create();
 
 	// Attach the shaders to shaderProgram
 	// シェーダーをshaderProgramにアタッチする
@@ -102,26 +106,129 @@ Shader::Shader(const char* vertexFile, const char* fragmentFile)
 	// リンク後は不要になるため、個別のシェーダーオブジェクトを削除する
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
+
+	// Look every uniform up once, so drawing never calls glGetUniformLocation
+	// 描画時にglGetUniformLocationを呼ばないよう、すべてのuniformを一度だけ調べる
+	if (success)
+	{
+		reflectUniforms();
+		bindUniformBlocks();
+	}
+}
+
+void Shader::reflectUniforms()
+{
+	GLint count = 0;
+	GLint maxLength = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	std::vector<GLchar> name(maxLength > 0 ? maxLength : 1);
+	for (GLint i = 0; i < count; i++)
+	{
+		GLsizei length = 0;
+		GLint arraySize = 0;
+		GLenum type = 0;
+		glGetActiveUniform(ID, (GLuint)i, (GLsizei)name.size(), &length, &arraySize, &type, name.data());
+
+		// Uniforms inside a block have no location (they are set through their buffer)
+		// ブロック内のuniformにはロケーションが無い（バッファを通して設定する）
+		GLint location = glGetUniformLocation(ID, name.data());
+		if (location < 0)
+			continue;
+
+		// Arrays are reported as "name[0]"; store them under their plain name
+		// 配列は"name[0]"として報告されるため、元の名前で保存する
+		std::string key(name.data(), length);
+		if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0)
+			key.resize(key.size() - 3);
+
+		Uniform uniform;
+		uniform.location = location;
+		uniforms[key] = uniform;
+	}
+}
+
+void Shader::bindUniformBlocks()
+{
+	// GLSL 3.30 cannot give a block a binding in the shader, so each block the program uses is pointed at its own here
+	// GLSL 3.30ではシェーダー内でブロックにバインディングを指定できないため、プログラムが使う各ブロックをここで割り当てる
+	for (GLuint binding = 0; binding < UNIFORM_BLOCK_COUNT; binding++)
+	{
+		GLuint index = glGetUniformBlockIndex(ID, UNIFORM_BLOCK_NAMES[binding]);
+		if (index != GL_INVALID_INDEX)
+			glUniformBlockBinding(ID, index, binding);
+	}
+}
+
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	auto found = uniforms.find(std::string_view(name));
+	return found != uniforms.end() ? found->second.location : -1;
+}
+
+Shader::Uniform* Shader::change(const char* name, const void* value, GLsizei size)
+{
+	auto found = uniforms.find(std::string_view(name));
+	if (found == uniforms.end())
+		return nullptr;
+
+	Uniform& uniform = found->second;
+	if (uniform.size == size && std::memcmp(uniform.value, value, size) == 0)
+		return nullptr;
+
+	uniform.size = size;
+	std::memcpy(uniform.value, value, size);
+	return &uniform;
+}
+
+void Shader::SetInt(const char* name, GLint value)
+{
+	if (Uniform* uniform = change(name, &value, sizeof(value)))
+		glUniform1i(uniform->location, value);
+}
+
+void Shader::SetFloat(const char* name, GLfloat value)
+{
+	if (Uniform* uniform = change(name, &value, sizeof(value)))
+		glUniform1f(uniform->location, value);
+}
+
+void Shader::SetVec3(const char* name, const glm::vec3& value)
+{
+	if (Uniform* uniform = change(name, glm::value_ptr(value), sizeof(value)))
+		glUniform3fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void Shader::SetVec4(const char* name, const glm::vec4& value)
+{
+	if (Uniform* uniform = change(name, glm::value_ptr(value), sizeof(value)))
+		glUniform4fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void Shader::SetMat3(const char* name, const glm::mat3& value)
+{
+	if (Uniform* uniform = change(name, glm::value_ptr(value), sizeof(value)))
+		glUniformMatrix3fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void Shader::Update(const Transform& transform)
+void Shader::SetMat4(const char* name, const glm::mat4& value)
 {
-	// Get the model matrix from Transform and send it to the shader
-	// Transformからモデル行列を取得し、シェーダーに送信する
-	glm::mat4 model = transform.GetModel();
-	glUniformMatrix4fv(glGetUniformLocation(ID, "transform"), 1, GL_FALSE, glm::value_ptr(model));
+	if (Uniform* uniform = change(name, glm::value_ptr(value), sizeof(value)))
+		glUniformMatrix4fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 void Shader::Activate()
 {
 	// Activate this shader program for rendering
 	// このシェーダープログラムをレンダリング用に有効化する
-	glUseProgram(ID);
+	GLState::UseProgram(ID);
 }
 
 void Shader::Delete()
 {
 	// Delete the shader program and free GPU resources
 	// シェーダープログラムを削除し、GPUリソースを解放する
-	glDeleteProgram(ID);
+	ID.Reset();
+	uniforms.clear();
 }
\ No newline at end of file
@@ -7,8 +7,12 @@
 #include<sstream>
 #include<iostream>
 #include<cerrno>
+#include<string_view>
+#include<functional>
+#include<unordered_map>
 #include<glm/gtc/type_ptr.hpp>
 #include "Transform.h"
+#include "GLHandle.h"
 
 // Reads the contents of a file and returns it as a string
 // ファイルの内容を読み込み、文字列として返す
@@ -18,25 +22,71 @@ class Shader
 {
 public:
 
-	// Reference ID of the Shader Program
-	// シェーダープログラムの参照ID
-	GLuint ID;
+	// Shader Program, deleted with the Shader (so Shaders can be moved but not copied; pass them by reference)
+	// シェーダープログラム（Shaderと共に削除されるため、Shaderはムーブできるがコピーできない。参照で渡す）
+	GLProgram ID;
 
 	// Constructor that builds the Shader Program from 2 different shaders
 	// 2つの異なるシェーダーからシェーダープログラムを構築するコンストラクタ
 	Shader(const char* vertexFile, const char* fragmentFile);
 
-	// Updates the shader with the latest transform data
-	// 最新のTransformデータでシェーダーを更新する
-	void Update(const Transform& transform);
+	// Typed uniform setters using the locations reflected after linking; a value equal to the one last
+	// set is not uploaded again, and names the program does not use are ignored. The program must be active.
+	// リンク後に取得したロケーションを使う型付きのuniform設定関数（前回設定した値と等しい値は再転送せず、
+	// プログラムが使っていない名前は無視する）。プログラムが有効化されている必要がある
+	void SetInt(const char* name, GLint value);
+	void SetFloat(const char* name, GLfloat value);
+	void SetVec3(const char* name, const glm::vec3& value);
+	void SetVec4(const char* name, const glm::vec4& value);
+	void SetMat3(const char* name, const glm::mat3& value);
+	void SetMat4(const char* name, const glm::mat4& value);
+
+	// Returns the location of an active uniform from the table, or -1 if the program does not use it
+	// 表からアクティブなuniformのロケーションを返す（プログラムが使っていない場合は-1）
+	GLint GetUniformLocation(const char* name) const;
 
 	// Activates the Shader Program
 	// シェーダープログラムを有効化する
 	void Activate();
 
-	// Deletes the Shader Program
-	// シェーダープログラムを削除する
+	// Deletes the Shader Program now (e.g. before the context is destroyed)
+	// シェーダープログラムを今すぐ削除する（例：コンテキストが破棄される前）
 	void Delete();
+
+private:
+
+	// Active uniform with the bytes last uploaded to it (size 0 until the first upload)
+	// アクティブなuniformと、最後に転送したバイト列（最初の転送まではsizeが0）
+	struct Uniform
+	{
+		GLint location;
+		GLsizei size = 0;
+		unsigned char value[sizeof(glm::mat4)];
+	};
+
+	// Hashes names as string_view so lookups by const char* allocate nothing
+	// const char*での検索でメモリを確保しないよう、名前をstring_viewとしてハッシュする
+	struct NameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+	};
+
+	// Active uniforms by name, filled once after linking
+	// 名前ごとのアクティブなuniform（リンク後に一度だけ埋める）
+	std::unordered_map<std::string, Uniform, NameHash, std::equal_to<>> uniforms;
+
+	// Asks the linked program for its active uniforms and their locations
+	// リンク済みプログラムにアクティブなuniformとそのロケーションを問い合わせる
+	void reflectUniforms();
+
+	// Binds the shared uniform blocks the program declares (see UBO.h) to their fixed binding points
+	// プログラムが宣言している共有uniformブロック（UBO.hを参照）を固定のバインディングポイントに結び付ける
+	void bindUniformBlocks();
+
+	// Returns the uniform if value differs from what it holds, remembering value; nullptr if nothing needs uploading
+	// valueが保持している値と異なればuniformを返し、valueを記録する（転送不要ならnullptr）
+	Uniform* change(const char* name, const void* value, GLsizei size);
 };
 
 #endif
\ No newline at end of file
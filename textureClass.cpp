@@ -2,17 +2,14 @@
 
 Texture::Texture(const char* image, const char* texType, GLuint slot, GLenum texFilter)
 {
-	// Define the type of the texture
-	// テクスチャの種類を定義する
-	type = texType;
-
 	// Create variables for width, height, and the number of color channels
 	// 画像の幅・高さ・カラーチャンネル数を格納する変数を作成
 	int widthImg, heightImg, numColCh;
 
-	// Since OpenGL's coordinate system differs from the stb library's system, we flip the image vertically
-	// OpenGLの座標系はstbライブラリと異なるため、画像を上下反転する
-	stbi_set_flip_vertically_on_load(true);
+	// Since OpenGL's coordinate system differs from the stb library's system, the image comes out flipped vertically
+	// (stb_image's flip flag is set once at startup, so worker threads decoding models never race on it)
+	// OpenGLの座標系はstbライブラリと異なるため、画像は上下反転されて出てくる
+	// （stb_imageの反転フラグは起動時に一度だけ設定するため、モデルをデコードするワーカースレッドと競合しない）
 
 	// Takes the image file name, and modifies width height and number of color channel values.
 	// The last argument lets you force a number of channels
@@ -22,18 +19,61 @@ Texture::Texture(const char* image, const char* texType, GLuint slot, GLenum tex
 	// 生のピクセルデータ、またはNULLを返す
 	unsigned char* bytes = stbi_load(image, &widthImg, &heightImg, &numColCh, 0);
 
-	// makes GLuint ID an array that holds a number (1) of texture objects
-	// GLuint ID に1つのテクスチャオブジェクトを生成する
-	glGenTextures(1, &ID);
+	// Stop here if the image could not be decoded
+	// 画像をデコードできなかった場合はここで中断する
+	if (bytes == NULL)
+		throw std::invalid_argument("Texture image could not be decoded");
 
-	// makes the active texture the specified slot (example GL_TEXTURE0)
-	// 指定されたスロット（例：GL_TEXTURE0）をアクティブにする
-	glActiveTexture(GL_TEXTURE0 + slot);
-	unit = slot;
+	create(TextureImage(bytes, widthImg, heightImg, numColCh, 0), texType, slot, texFilter, true);
+
+	// deallocate memory for bytes
+	// 画像データのメモリを解放する
+	stbi_image_free(bytes);
+}
+
+Texture::Texture(const unsigned char* encoded, size_t size, const char* texType, GLuint slot, GLenum texFilter)
+{
+	// Create variables for width, height, and the number of color channels
+	// 画像の幅・高さ・カラーチャンネル数を格納する変数を作成
+	int widthImg, heightImg, numColCh;
+
+	// Decode the image straight from memory
+	// メモリから直接画像をデコードする
+	unsigned char* bytes = stbi_load_from_memory(encoded, (int)size, &widthImg, &heightImg, &numColCh, 0);
+
+	// Stop here if the image could not be decoded
+	// 画像をデコードできなかった場合はここで中断する
+	if (bytes == NULL)
+		throw std::invalid_argument("Texture image could not be decoded");
+
+	create(TextureImage(bytes, widthImg, heightImg, numColCh, 0), texType, slot, texFilter, true);
+
+	// deallocate memory for bytes
+	// 画像データのメモリを解放する
+	stbi_image_free(bytes);
+}
 
-	// Binds the texture object array to the specified type (example GL_TEXTURE_2D)
-	// 指定されたタイプ（例：GL_TEXTURE_2D）にテクスチャをバインドする
-	glBindTexture(GL_TEXTURE_2D, ID);
+Texture::Texture(const TextureImage& image, const char* texType, GLuint slot, GLenum texFilter, bool uploadPixels)
+{
+	create(image, texType, slot, texFilter, uploadPixels);
+}
+
+void Texture::create(const TextureImage& image, const char* texType, GLuint slot, GLenum texFilter, bool uploadPixels)
+{
+	// Define the type of the texture
+	// テクスチャの種類を定義する
+	type = texType;
+	internalFormat = image.internalFormat;
+	bytes = image.GetBytes();
+
+	// Creates one texture object owned by ID
+	// IDが所有するテクスチャオブジェクトを1つ生成する
+	ID = GLTexture::Create();
+
+	// Binds the texture object to the specified slot (example GL_TEXTURE0) and type (example GL_TEXTURE_2D)
+	// 指定されたスロット（例：GL_TEXTURE0）とタイプ（例：GL_TEXTURE_2D）にテクスチャをバインドする
+	unit = slot;
+	GLState::BindTexture(slot, GL_TEXTURE_2D, ID);
 
 	// Determine how textures are rendered when they are minified or magnified than the native resolution.
 	// We can use GL_LINEAR or GL_NEAREST
@@ -47,92 +87,73 @@ Texture::Texture(const char* image, const char* texType, GLuint slot, GLenum tex
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	if (numColCh == 4)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_RGBA,
-			widthImg,
-			heightImg,
-			0,
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
-	else if (numColCh == 3)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_RGBA,
-			widthImg,
-			heightImg,
-			0,
-			GL_RGB,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
-	else if (numColCh == 1)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_RGBA,
-			widthImg,
-			heightImg,
-			0,
-			GL_RED,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
+	// Rows are tightly packed, which matters for RGB and RED images whose width is not a multiple of 4
+	// 行は隙間なく詰められている（幅が4の倍数でないRGBやRED画像で重要）
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// Upload every given mip level, each half the size of the previous one
+	// Compressed levels go to the GPU as they are, with no decoding on the way
+	// 与えられた各ミップレベルを転送する（各レベルは前のレベルの半分のサイズ）
+	// 圧縮されたレベルは途中でデコードせず、そのままGPUに送る
+	for (int level = 0; level < (int)image.levels.size(); level++)
+	{
+		const void* pixels = uploadPixels ? image.levels[level].data : nullptr;
+		int levelWidth = image.GetLevelWidth(level);
+		int levelHeight = image.GetLevelHeight(level);
+
+		if (image.IsCompressed())
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, image.internalFormat, levelWidth, levelHeight, 0, (GLsizei)image.levels[level].size, pixels);
+		else
+			glTexImage2D(GL_TEXTURE_2D, level, image.internalFormat, levelWidth, levelHeight, 0, image.format, GL_UNSIGNED_BYTE, pixels);
+	}
+
+	if (image.generateMipmap)
+	{
+		// Create smaller resolutions of the same image to handle cases where the texture is being rendered within a small area of the screen
+		// (without pixels there is nothing to build from yet; whoever uploads them generates the mipmaps)
+		// テクスチャが小さく表示される場合に備えてミップマップを生成する
+		// （ピクセルが無い場合はまだ生成元が無いため、ピクセルを転送する側がミップマップを生成する）
+		if (uploadPixels)
+			glGenerateMipmap(GL_TEXTURE_2D);
+	}
 	else
-		throw std::invalid_argument("Automatic Texture type recognition failed");
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image.levels.size() - 1);
+	}
 
-	// Create smaller resolutions of the same image to handle cases where the texture is being rendered within a small area of the screen
-	// テクスチャが小さく表示される場合に備えてミップマップを生成する
-	glGenerateMipmap(GL_TEXTURE_2D);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-	// deallocate memory for bytes
-	// 画像データのメモリを解放する
-	stbi_image_free(bytes);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::BindTexture(slot, GL_TEXTURE_2D, 0);
 }
 
 void Texture::texUnit(Shader& shader, const char* uniform, GLuint unit)
 {
-	// Gets the location of the uniform variable in the shader
-	// シェーダー内のuniform変数の場所を取得する
-	GLuint texUni = glGetUniformLocation(shader.ID, uniform);
-
 	// Activates the shader before setting the uniform
 	// uniformを設定する前にシェーダーを有効化する
 	shader.Activate();
 
-	// Assigns the texture unit to the uniform
-	// テクスチャユニットをuniformに割り当てる
-	glUniform1i(texUni, unit);
+	// Assigns the texture unit to the uniform (the shader already knows its location)
+	// テクスチャユニットをuniformに割り当てる（ロケーションはシェーダーが既に知っている）
+	shader.SetInt(uniform, (GLint)unit);
 }
 
 // Binds the texture object array to the type
 // テクスチャをバインドする
 void Texture::Bind()
 {
-	glActiveTexture(GL_TEXTURE0 + unit);
-	glBindTexture(GL_TEXTURE_2D, ID);
+	GLState::BindTexture(unit, GL_TEXTURE_2D, ID);
 }
 
 // Unbinds the texture object array to the type
 // テクスチャのバインドを解除する
 void Texture::Unbind()
 {
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::BindTexture(unit, GL_TEXTURE_2D, 0);
 }
 
-// Deletes the texture
-// テクスチャを削除する
+// Deletes the texture now instead of when the Texture is destroyed
+// Textureの破棄時ではなく今すぐテクスチャを削除する
 void Texture::Delete()
 {
-	glDeleteTextures(1, &ID);
+	ID.Reset();
 }
\ No newline at end of file
@@ -5,14 +5,16 @@
 #include<stb/stb_image.h>
 
 #include "shaderClass.h"
+#include "TextureImage.h"
+#include "GLHandle.h"
 
 class Texture
 {
 public:
 
-	// OpenGL texture object ID
-	// OpenGLのテクスチャオブジェクトID
-	GLuint ID;
+	// OpenGL texture object, deleted with the Texture (so Textures can be moved but not copied)
+	// OpenGLのテクスチャオブジェクト（Textureと共に削除されるため、Textureはムーブできるがコピーできない）
+	GLTexture ID;
 
 	// Type of the texture (e.g., diffuse, specular, etc.)
 	// テクスチャの種類（例：diffuse、specularなど）
@@ -22,10 +24,25 @@ public:
 	// テクスチャユニットのスロット番号
 	GLuint unit;
 
+	// Storage format and the GPU memory the texture takes, mips included
+	// ストレージのフォーマットと、テクスチャが使用するGPUメモリ量（ミップを含む）
+	GLenum internalFormat;
+	size_t bytes;
+
 	// Constructor that loads and creates a texture
 	// テクスチャを読み込み生成するコンストラクタ
 	Texture(const char* image, const char* texType, GLuint slot, GLenum texFilter);
 
+	// Constructor that decodes an image file already in memory (e.g. embedded in a .glb)
+	// メモリ上の画像ファイル（例：.glbに埋め込まれたもの）をデコードするコンストラクタ
+	Texture(const unsigned char* encoded, size_t size, const char* texType, GLuint slot, GLenum texFilter);
+
+	// Constructor that uploads already decoded or block-compressed pixels
+	// Without uploadPixels it only allocates storage, and the pixels are uploaded later (e.g. by TextureStreamer)
+	// デコード済みまたはブロック圧縮済みのピクセルを転送するコンストラクタ
+	// uploadPixelsがfalseの場合はストレージの確保のみを行い、ピクセルは後で転送する（例：TextureStreamer）
+	Texture(const TextureImage& image, const char* texType, GLuint slot, GLenum texFilter, bool uploadPixels = true);
+
 	// Assigns the texture unit to a shader uniform
 	// シェーダーのuniform変数にテクスチャユニットを割り当てる
 	void texUnit(Shader& shader, const char* uniform, GLuint unit);
@@ -41,6 +58,12 @@ public:
 	// Deletes the texture from GPU memory
 	// GPUメモリからテクスチャを削除する
 	void Delete();
+
+private:
+
+	// Creates the GL texture from an image (only its storage if uploadPixels is false)
+	// 画像からGLテクスチャを作成する（uploadPixelsがfalseの場合はストレージのみ）
+	void create(const TextureImage& image, const char* texType, GLuint slot, GLenum texFilter, bool uploadPixels);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "BlockCompress.h"
+
+#include <cmath>
+#include <cstdint>
+
+// Copies one 4x4 block out of the image as RGBA, clamping at the edges
+// 画像から4x4ブロックを1つRGBAとして取り出す（端ではクランプする）
+static void fetch_block(const unsigned char* pixels, int width, int height, int channels, int bx, int by, unsigned char block[16][4])
+{
+	for (int y = 0; y < 4; y++)
+	{
+		int sy = by * 4 + y < height ? by * 4 + y : height - 1;
+		for (int x = 0; x < 4; x++)
+		{
+			int sx = bx * 4 + x < width ? bx * 4 + x : width - 1;
+			const unsigned char* pixel = pixels + ((size_t)sy * width + sx) * channels;
+			for (int c = 0; c < 3; c++)
+				block[y * 4 + x][c] = pixel[channels >= 3 ? c : 0];
+			block[y * 4 + x][3] = channels == 4 ? pixel[3] : 255;
+		}
+	}
+}
+
+// Packs an RGB color into 5:6:5 bits with rounding
+// RGBカラーを丸めて5:6:5ビットに詰める
+static uint16_t pack_565(const float color[3])
+{
+	int r = (int)std::lround(color[0] < 0 ? 0 : color[0] > 255 ? 31 : color[0] * 31.0f / 255.0f);
+	int g = (int)std::lround(color[1] < 0 ? 0 : color[1] > 255 ? 63 : color[1] * 63.0f / 255.0f);
+	int b = (int)std::lround(color[2] < 0 ? 0 : color[2] > 255 ? 31 : color[2] * 31.0f / 255.0f);
+	return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Expands 5:6:5 bits back to 8 bits per channel the way the GPU does
+// GPUと同じ方法で5:6:5ビットをチャンネルあたり8ビットに戻す
+static void unpack_565(uint16_t packed, int color[3])
+{
+	int r = (packed >> 11) & 31;
+	int g = (packed >> 5) & 63;
+	int b = packed & 31;
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+// Writes the 8-byte color part of a block: endpoints along the principal axis of the colors,
+// then the nearest of the four palette entries for every pixel
+// ブロックの8バイトのカラー部を書き込む：端点は色の主軸上に取り、
+// 各ピクセルには4つのパレットのうち最も近いものを選ぶ
+static void encode_color(const unsigned char block[16][4], unsigned char* out)
+{
+	// Mean and covariance of the colors
+	// 色の平均と共分散
+	float mean[3] = { 0, 0, 0 };
+	for (int i = 0; i < 16; i++)
+		for (int c = 0; c < 3; c++)
+			mean[c] += block[i][c] / 16.0f;
+
+	float cov[6] = { 0, 0, 0, 0, 0, 0 };
+	for (int i = 0; i < 16; i++)
+	{
+		float r = block[i][0] - mean[0];
+		float g = block[i][1] - mean[1];
+		float b = block[i][2] - mean[2];
+		cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+		cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+	}
+
+	// Principal axis by power iteration (luminance if the block is flat)
+	// べき乗法による主軸（ブロックが平坦な場合は輝度方向）
+	float axis[3] = { 0.299f, 0.587f, 0.114f };
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float next[3] =
+		{
+			cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+			cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+			cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+		};
+		float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+		if (length < 1e-6f)
+			break;
+		for (int c = 0; c < 3; c++)
+			axis[c] = next[c] / length;
+	}
+
+	// Extent of the colors along the axis, inset slightly to spend precision on the bulk of them
+	// 軸に沿った色の範囲（大部分の色に精度を使うよう、わずかに内側に寄せる）
+	float low = 1e9f, high = -1e9f;
+	for (int i = 0; i < 16; i++)
+	{
+		float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+		low = t < low ? t : low;
+		high = t > high ? t : high;
+	}
+	float inset = (high - low) / 16.0f;
+	low += inset;
+	high -= inset;
+
+	float end0[3], end1[3];
+	for (int c = 0; c < 3; c++)
+	{
+		end0[c] = mean[c] + axis[c] * high;
+		end1[c] = mean[c] + axis[c] * low;
+	}
+	uint16_t color0 = pack_565(end0);
+	uint16_t color1 = pack_565(end1);
+
+	// color0 > color1 selects the four-color mode
+	// color0 > color1 の場合に4色モードになる
+	if (color0 < color1)
+	{
+		uint16_t swap = color0;
+		color0 = color1;
+		color1 = swap;
+	}
+
+	int palette[4][3];
+	unpack_565(color0, palette[0]);
+	unpack_565(color1, palette[1]);
+	for (int c = 0; c < 3; c++)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			int best = 0;
+			int bestError = 1 << 30;
+			for (int p = 0; p < 4; p++)
+			{
+				int dr = block[i][0] - palette[p][0];
+				int dg = block[i][1] - palette[p][1];
+				int db = block[i][2] - palette[p][2];
+				int error = dr * dr + dg * dg + db * db;
+				if (error < bestError)
+				{
+					bestError = error;
+					best = p;
+				}
+			}
+			indices |= (uint32_t)best << (i * 2);
+		}
+	}
+
+	out[0] = (unsigned char)(color0 & 0xFF);
+	out[1] = (unsigned char)(color0 >> 8);
+	out[2] = (unsigned char)(color1 & 0xFF);
+	out[3] = (unsigned char)(color1 >> 8);
+	for (int i = 0; i < 4; i++)
+		out[4 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+// Writes the 8-byte alpha part of a BC3 block: the alpha range split into eight steps
+// BC3ブロックの8バイトのアルファ部を書き込む：アルファの範囲を8段階に分ける
+static void encode_alpha(const unsigned char block[16][4], unsigned char* out)
+{
+	int alpha0 = 0, alpha1 = 255;
+	for (int i = 0; i < 16; i++)
+	{
+		alpha0 = block[i][3] > alpha0 ? block[i][3] : alpha0;
+		alpha1 = block[i][3] < alpha1 ? block[i][3] : alpha1;
+	}
+
+	// alpha0 > alpha1 selects the eight-value mode
+	// alpha0 > alpha1 の場合に8値モードになる
+	int palette[8];
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	for (int p = 1; p < 7; p++)
+		palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+
+	uint64_t indices = 0;
+	if (alpha0 != alpha1)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			int best = 0;
+			int bestError = 1 << 30;
+			for (int p = 0; p < 8; p++)
+			{
+				int error = block[i][3] > palette[p] ? block[i][3] - palette[p] : palette[p] - block[i][3];
+				if (error < bestError)
+				{
+					bestError = error;
+					best = p;
+				}
+			}
+			indices |= (uint64_t)best << (i * 3);
+		}
+	}
+
+	out[0] = (unsigned char)alpha0;
+	out[1] = (unsigned char)alpha1;
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+std::vector<unsigned char> compress_bc1(const unsigned char* pixels, int width, int height, int channels)
+{
+	int blocksX = (width + 3) / 4;
+	int blocksY = (height + 3) / 4;
+	std::vector<unsigned char> out((size_t)blocksX * blocksY * 8);
+
+	unsigned char block[16][4];
+	for (int by = 0; by < blocksY; by++)
+		for (int bx = 0; bx < blocksX; bx++)
+		{
+			fetch_block(pixels, width, height, channels, bx, by, block);
+			encode_color(block, &out[((size_t)by * blocksX + bx) * 8]);
+		}
+
+	return out;
+}
+
+std::vector<unsigned char> compress_bc3(const unsigned char* pixels, int width, int height)
+{
+	int blocksX = (width + 3) / 4;
+	int blocksY = (height + 3) / 4;
+	std::vector<unsigned char> out((size_t)blocksX * blocksY * 16);
+
+	unsigned char block[16][4];
+	for (int by = 0; by < blocksY; by++)
+		for (int bx = 0; bx < blocksX; bx++)
+		{
+			fetch_block(pixels, width, height, 4, bx, by, block);
+			unsigned char* dest = &out[((size_t)by * blocksX + bx) * 16];
+			encode_alpha(block, dest);
+			encode_color(block, dest + 8);
+		}
+
+	return out;
+}
\ No newline at end of file
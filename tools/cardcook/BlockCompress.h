@@ -0,0 +1,19 @@
+#ifndef BLOCK_COMPRESS_H
+#define BLOCK_COMPRESS_H
+
+#include <vector>
+
+// Block compression used by cardcook: every 4x4 block of pixels becomes 8 bytes (BC1) or 16 bytes (BC3)
+// Edge blocks of images whose size is not a multiple of 4 repeat the last row and column.
+// cardcookが使うブロック圧縮：4x4ピクセルのブロックごとに8バイト（BC1）または16バイト（BC3）になる
+// サイズが4の倍数でない画像の端のブロックは、最後の行と列を繰り返す
+
+// Compresses an RGB or RGBA image into BC1 (opaque; alpha is ignored)
+// RGBまたはRGBA画像をBC1に圧縮する（不透明。アルファは無視される）
+std::vector<unsigned char> compress_bc1(const unsigned char* pixels, int width, int height, int channels);
+
+// Compresses an RGBA image into BC3 (interpolated alpha)
+// RGBA画像をBC3に圧縮する（補間アルファ）
+std::vector<unsigned char> compress_bc3(const unsigned char* pixels, int width, int height);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,367 @@
+// cardcook: cooks glTF/GLB card models into a card pack the game maps at startup
+// cardcook：glTF/GLBのカードモデルを、ゲームが起動時にマッピングするカードパックに調理する
+//
+// Usage (from the game's working directory, so the stored paths match the ones the game asks for):
+// 使い方（保存されるパスがゲームの要求するパスと一致するよう、ゲームの作業ディレクトリから実行する）：
+//   cardcook cards.pak models/card/SimplePlayingCard.gltf models/johncard/JohnSimplePlayingCard.gltf ...
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+#include <unordered_map>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "ModelData.h"
+#include "CardPack.h"
+#include "GeometryCache.h"
+#include "KTX2.h"
+#include "BlockCompress.h"
+
+// The cooked level table must hold every level ModelData can build
+// 調理済みのレベル表は、ModelDataが作れるすべてのレベルを保持できなければならない
+static_assert(CARD_PACK_MAX_LODS == MAX_MESH_LODS, "Card pack level of detail table does not match the mesh optimizer");
+
+// Data section of the pack, with offsets relative to its start until the file is written
+// パックのデータ部（ファイルを書き出すまでオフセットはデータ部の先頭からの相対値）
+static std::vector<unsigned char> packData;
+
+// Appends bytes to the data section, 16-byte aligned, and returns their offset
+// データ部に16バイト境界でバイト列を追加し、そのオフセットを返す
+static uint64_t append(const void* bytes, size_t size)
+{
+	packData.resize((packData.size() + 15) & ~(size_t)15);
+
+	uint64_t offset = packData.size();
+	packData.insert(packData.end(), (const unsigned char*)bytes, (const unsigned char*)bytes + size);
+	return offset;
+}
+
+// Builds the full mip chain with a 2x2 box filter, largest level first, tightly packed
+// 2x2ボックスフィルタで完全なミップチェーンを作成する（最大レベルから順に隙間なく格納）
+static std::vector<unsigned char> buildMipChain(const ImageData& image, uint32_t& mipCount)
+{
+	int width = image.width;
+	int height = image.height;
+	int channels = image.channels;
+
+	std::vector<unsigned char> chain(image.pixels.get(), image.pixels.get() + (size_t)width * height * channels);
+	size_t level = 0;
+	mipCount = 1;
+
+	while (width > 1 || height > 1)
+	{
+		int nextWidth = width > 1 ? width / 2 : 1;
+		int nextHeight = height > 1 ? height / 2 : 1;
+		size_t next = chain.size();
+		chain.resize(next + (size_t)nextWidth * nextHeight * channels);
+
+		// Average each 2x2 block (edges of odd sizes reuse the last row or column)
+		// 各2x2ブロックを平均する（奇数サイズの端は最後の行または列を再利用する）
+		for (int y = 0; y < nextHeight; y++)
+		{
+			int y0 = y * 2;
+			int y1 = y0 + 1 < height ? y0 + 1 : y0;
+			for (int x = 0; x < nextWidth; x++)
+			{
+				int x0 = x * 2;
+				int x1 = x0 + 1 < width ? x0 + 1 : x0;
+				for (int c = 0; c < channels; c++)
+				{
+					unsigned int sum =
+						chain[level + ((size_t)y0 * width + x0) * channels + c] +
+						chain[level + ((size_t)y0 * width + x1) * channels + c] +
+						chain[level + ((size_t)y1 * width + x0) * channels + c] +
+						chain[level + ((size_t)y1 * width + x1) * channels + c];
+					chain[next + ((size_t)y * nextWidth + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+
+		level = next;
+		width = nextWidth;
+		height = nextHeight;
+		mipCount++;
+	}
+
+	return chain;
+}
+
+// Encodes every level of a mip chain and wraps them in a KTX2 file:
+// BC1 for opaque color, BC3 when any pixel is translucent, and plain R8 for single-channel images
+// ミップチェーンの各レベルをエンコードしてKTX2ファイルにまとめる：
+// 不透明な色はBC1、半透明のピクセルがあればBC3、1チャンネルの画像はそのままR8
+static std::vector<unsigned char> encodeTexture(const ImageData& image, const std::vector<unsigned char>& chain, uint32_t mipCount, uint32_t& format)
+{
+	int channels = image.channels;
+	if (channels == 2)
+		throw std::invalid_argument("Two-channel textures are not supported");
+
+	bool translucent = false;
+	if (channels == 4)
+		for (size_t i = 3; i < (size_t)image.width * image.height * 4 && !translucent; i += 4)
+			translucent = image.pixels.get()[i] != 255;
+
+	format = channels == 1 ? KTX2_FORMAT_R8_UNORM : translucent ? KTX2_FORMAT_BC3_UNORM : KTX2_FORMAT_BC1_RGB_UNORM;
+
+	std::vector<std::vector<unsigned char>> levels;
+	const unsigned char* level = chain.data();
+	int width = image.width;
+	int height = image.height;
+	for (uint32_t i = 0; i < mipCount; i++)
+	{
+		size_t levelSize = (size_t)width * height * channels;
+		if (format == KTX2_FORMAT_R8_UNORM)
+			levels.push_back(std::vector<unsigned char>(level, level + levelSize));
+		else if (format == KTX2_FORMAT_BC3_UNORM)
+			levels.push_back(compress_bc3(level, width, height));
+		else
+			levels.push_back(compress_bc1(level, width, height, channels));
+
+		level += levelSize;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return write_ktx2(format, image.width, image.height, levels);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: cardcook <output.pak> <model.gltf|model.glb>..." << std::endl;
+		return 1;
+	}
+
+	// Decode images flipped for OpenGL, exactly as the game does (set once, since the flag is global in stb_image)
+	// ゲームと同じくOpenGL向けに上下反転して画像をデコードする（stb_imageではフラグがグローバルなため一度だけ設定する）
+	stbi_set_flip_vertically_on_load(true);
+
+	std::vector<CardPackModel> models;
+	std::vector<CardPackMesh> meshes;
+	std::vector<CardPackTexture> textures;
+
+	// Identical geometry and pixels are stored once and shared by offset
+	// 同一のジオメトリとピクセルは一度だけ格納し、オフセットで共有する
+	std::unordered_map<uint64_t, CardPackMesh> cookedGeometry;
+	std::unordered_map<uint64_t, CardPackTexture> cookedPixels;
+
+	// Texture sizes before and after compression, for the report
+	// 報告用の、圧縮前後のテクスチャサイズ
+	size_t rawBytes = 0;
+	size_t cookedBytes = 0;
+
+	// Vertex sizes before and after packing, for the report
+	// 報告用の、パック前後の頂点サイズ
+	size_t floatVertexBytes = 0;
+	size_t cookedVertexBytes = 0;
+
+	try
+	{
+		for (int arg = 2; arg < argc; arg++)
+		{
+			const char* file = argv[arg];
+			std::string name = CardPack::Key(file);
+			if (name.size() >= sizeof(CardPackModel::name))
+			{
+				std::cout << "Model path is too long for a card pack: " << name << std::endl;
+				return 1;
+			}
+
+			// Decode the model exactly as the game would
+			// ゲームと全く同じ方法でモデルをデコードする
+			ModelData data(file);
+
+			CardPackModel model = {};
+			std::memcpy(model.name, name.c_str(), name.size());
+			model.firstMesh = (uint32_t)meshes.size();
+			model.meshCount = (uint32_t)data.meshes.size();
+			model.firstTexture = (uint32_t)textures.size();
+			model.textureCount = (uint32_t)data.images.size();
+
+			for (const ImageData& image : data.images)
+			{
+				CardPackTexture texture = {};
+				texture.type = std::strcmp(image.type, "specular") == 0 ? CARD_PACK_SPECULAR : CARD_PACK_DIFFUSE;
+				texture.width = image.width;
+				texture.height = image.height;
+				texture.channels = image.channels;
+
+				// Reuse the texture of an identical image cooked earlier
+				// 以前に調理した同一画像のテクスチャを再利用する
+				uint64_t hash = GeometryCache::HashBytes(&texture.width, 3 * sizeof(uint32_t));
+				hash = GeometryCache::HashBytes(image.pixels.get(), (size_t)image.width * image.height * image.channels, hash);
+
+				auto found = cookedPixels.find(hash);
+				if (found != cookedPixels.end())
+				{
+					texture.mipCount = found->second.mipCount;
+					texture.format = found->second.format;
+					texture.dataOffset = found->second.dataOffset;
+					texture.dataSize = found->second.dataSize;
+				}
+				else
+				{
+					std::vector<unsigned char> chain = buildMipChain(image, texture.mipCount);
+					std::vector<unsigned char> ktx = encodeTexture(image, chain, texture.mipCount, texture.format);
+					texture.dataOffset = append(ktx.data(), ktx.size());
+					texture.dataSize = ktx.size();
+					rawBytes += chain.size();
+					cookedBytes += ktx.size();
+					cookedPixels[hash] = texture;
+				}
+
+				textures.push_back(texture);
+			}
+
+			for (const MeshData& source : data.meshes)
+			{
+				CardPackMesh mesh = {};
+				std::memcpy(mesh.matrix, glm::value_ptr(source.matrix), sizeof(mesh.matrix));
+				mesh.hash = source.hash;
+
+				// Reuse geometry cooked under the same hash only if its shape matches too, since the hash is only a key
+				// ハッシュはキーに過ぎないため、同じハッシュで調理済みのジオメトリは形も一致する場合のみ再利用する
+				auto found = cookedGeometry.find(source.hash);
+				uint32_t indexSize = source.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+				if (found != cookedGeometry.end()
+					&& found->second.vertexCount == (uint32_t)source.vertices.size()
+					&& found->second.indexCount == (uint32_t)source.GetIndexCount()
+					&& found->second.indexSize == indexSize)
+				{
+					mesh.vertexCount = found->second.vertexCount;
+					mesh.indexCount = found->second.indexCount;
+					mesh.indexSize = found->second.indexSize;
+					mesh.vertexFormat = found->second.vertexFormat;
+					mesh.vertexOffset = found->second.vertexOffset;
+					mesh.indexOffset = found->second.indexOffset;
+					mesh.lodCount = found->second.lodCount;
+					std::memcpy(mesh.boundsCenter, found->second.boundsCenter, sizeof(mesh.boundsCenter));
+					mesh.boundsRadius = found->second.boundsRadius;
+					std::memcpy(mesh.boundsExtents, found->second.boundsExtents, sizeof(mesh.boundsExtents));
+					std::memcpy(mesh.lods, found->second.lods, sizeof(mesh.lods));
+				}
+				else
+				{
+					// Vertices are stored in the exact layout the VBO expects, packed whenever the mesh survives it
+					// 頂点はVBOが期待するレイアウトそのままで格納する（メッシュが耐えられる場合はパックする）
+					mesh.vertexCount = (uint32_t)source.vertices.size();
+					if (can_pack_vertices(source.vertices))
+					{
+						std::vector<PackedVertex> packed = pack_vertices(source.vertices);
+						mesh.vertexFormat = VERTEX_FORMAT_PACKED;
+						mesh.vertexOffset = append(packed.data(), packed.size() * sizeof(PackedVertex));
+						cookedVertexBytes += packed.size() * sizeof(PackedVertex);
+					}
+					else
+					{
+						mesh.vertexFormat = VERTEX_FORMAT_FLOAT;
+						mesh.vertexOffset = append(source.vertices.data(), source.vertices.size() * sizeof(Vertex));
+						cookedVertexBytes += source.vertices.size() * sizeof(Vertex);
+					}
+					floatVertexBytes += source.vertices.size() * sizeof(Vertex);
+
+					// Indices keep the width ModelData decoded them in (16 bits whenever every vertex can be reached)
+					// インデックスはModelDataがデコードした幅のまま格納する（すべての頂点を参照できれば16ビット）
+					mesh.indexCount = (uint32_t)source.GetIndexCount();
+					mesh.indexSize = indexSize;
+					mesh.indexOffset = append(source.GetIndexData(), (size_t)mesh.indexCount * mesh.indexSize);
+
+					// Levels of detail are ranges of those indices, built by ModelData
+					// 詳細度レベルはそのインデックスの範囲（ModelDataが作成済み）
+					mesh.lodCount = source.lods.count;
+					std::memcpy(mesh.boundsCenter, glm::value_ptr(source.lods.center), sizeof(mesh.boundsCenter));
+					mesh.boundsRadius = source.lods.radius;
+					std::memcpy(mesh.boundsExtents, glm::value_ptr(source.lods.extents), sizeof(mesh.boundsExtents));
+					for (unsigned int l = 0; l < source.lods.count; l++)
+					{
+						mesh.lods[l].firstIndex = source.lods.levels[l].firstIndex;
+						mesh.lods[l].indexCount = source.lods.levels[l].indexCount;
+						mesh.lods[l].error = source.lods.levels[l].error;
+						mesh.lods[l].impostor = source.lods.levels[l].impostor ? 1 : 0;
+					}
+					cookedGeometry[source.hash] = mesh;
+
+					// ModelData already optimized the mesh; report what that did to the vertex cache
+					// ModelDataがメッシュを最適化済みのため、それが頂点キャッシュに与えた効果を報告する
+					const MeshOptimizeReport& report = source.optimization;
+					std::cout << std::fixed << std::setprecision(2)
+						<< "  Mesh " << meshes.size() - model.firstMesh << ": "
+						<< report.verticesBefore << " -> " << report.verticesAfter << " vertices, "
+						<< source.lods.levels[0].indexCount / 3 << " triangles, ACMR " << report.before.acmr << " -> " << report.after.acmr
+						<< ", ATVR " << report.before.atvr << " -> " << report.after.atvr << std::endl;
+
+					std::cout << "    LODs:";
+					for (unsigned int l = 0; l < source.lods.count; l++)
+					{
+						const MeshLod& lod = source.lods.levels[l];
+						std::cout << (l > 0 ? ", " : " ") << lod.indexCount / 3 << " triangles";
+						if (l > 0)
+							std::cout << " (" << (lod.impostor ? "impostor, " : "") << "error " << lod.error << ")";
+					}
+					std::cout << std::endl;
+				}
+
+				meshes.push_back(mesh);
+			}
+
+			std::cout << "Cooked " << name << ": " << model.meshCount << " meshes, " << model.textureCount << " textures" << std::endl;
+			models.push_back(model);
+		}
+	}
+	catch (const std::exception& error)
+	{
+		std::cout << "Cooking failed: " << error.what() << std::endl;
+		return 1;
+	}
+	catch (int error)
+	{
+		// MappedFile throws errno when a file cannot be opened
+		// MappedFileはファイルを開けない場合にerrnoを投げる
+		std::cout << "Cooking failed: could not open a model file (" << std::strerror(error) << ")" << std::endl;
+		return 1;
+	}
+
+	// Tables follow the header, and the data section follows the tables
+	// 各表はヘッダの後に、データ部は各表の後に続く
+	CardPackHeader header = {};
+	header.magic = CARD_PACK_MAGIC;
+	header.version = CARD_PACK_VERSION;
+	header.modelCount = (uint32_t)models.size();
+	header.meshCount = (uint32_t)meshes.size();
+	header.textureCount = (uint32_t)textures.size();
+	header.modelsOffset = sizeof(CardPackHeader);
+	header.meshesOffset = header.modelsOffset + models.size() * sizeof(CardPackModel);
+	header.texturesOffset = header.meshesOffset + meshes.size() * sizeof(CardPackMesh);
+
+	uint64_t dataStart = (header.texturesOffset + textures.size() * sizeof(CardPackTexture) + 15) & ~(uint64_t)15;
+	for (CardPackMesh& mesh : meshes)
+	{
+		mesh.vertexOffset += dataStart;
+		mesh.indexOffset += dataStart;
+	}
+	for (CardPackTexture& texture : textures)
+		texture.dataOffset += dataStart;
+
+	std::ofstream out(argv[1], std::ios::binary);
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)models.data(), models.size() * sizeof(CardPackModel));
+	out.write((const char*)meshes.data(), meshes.size() * sizeof(CardPackMesh));
+	out.write((const char*)textures.data(), textures.size() * sizeof(CardPackTexture));
+
+	std::vector<char> padding(dataStart - (uint64_t)out.tellp(), 0);
+	out.write(padding.data(), padding.size());
+	out.write((const char*)packData.data(), packData.size());
+
+	if (!out)
+	{
+		std::cout << "Failed to write " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::cout << "Vertices: " << floatVertexBytes / 1024 << " KB of floats packed into " << cookedVertexBytes / 1024 << " KB" << std::endl;
+	std::cout << "Textures: " << rawBytes / 1024 << " KB of pixels cooked into " << cookedBytes / 1024 << " KB" << std::endl;
+	std::cout << "Wrote " << argv[1] << " (" << (dataStart + packData.size()) / 1024 << " KB)" << std::endl;
+	return 0;
+}
\ No newline at end of file